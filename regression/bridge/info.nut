@@ -0,0 +1,13 @@
+class Bridge extends AIInfo {
+	function GetAuthor()      { return "OpenTTD NoAI Developers Team"; }
+	function GetName()        { return "Bridge"; }
+	function GetShortName()   { return "REGB"; }
+	function GetDescription() { return "This runs vehicles over a bridge and reports their progress. On the same map the result should always be the same."; }
+	function GetVersion()     { return 1; }
+	function GetAPIVersion()  { return "13"; }
+	function GetDate()        { return "2007-03-18"; }
+	function CreateInstance() { return "Bridge"; }
+	function UseAsRandomAI()  { return false; }
+}
+
+RegisterAI(Bridge());
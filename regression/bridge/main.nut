@@ -0,0 +1,84 @@
+class Bridge extends AIController {
+	west_depot = null;
+	east_depot = null;
+
+	function Start();
+};
+
+/* The track runs along the X axis from the west depot to the east depot, with a bridge halfway. */
+const TRACK_Y = 20;
+const WEST_X = 10;
+const EAST_X = 40;
+const BRIDGE_WEST_X = 22;
+const BRIDGE_EAST_X = 28;
+
+function Bridge::PrepareLand()
+{
+	local tiles = AITileList();
+	tiles.AddRectangle(AIMap.GetTileIndex(WEST_X - 1, TRACK_Y - 1), AIMap.GetTileIndex(EAST_X + 1, TRACK_Y + 1));
+	foreach (tile, _ in tiles) {
+		if (!AITile.IsBuildable(tile)) AITile.DemolishTile(tile);
+	}
+	/* LevelTiles works on tile corners, so the end is one tile further to also level the south corners of the last tiles. */
+	print("  LevelTiles():            " + AITile.LevelTiles(AIMap.GetTileIndex(WEST_X - 1, TRACK_Y - 1), AIMap.GetTileIndex(EAST_X + 2, TRACK_Y + 2)));
+}
+
+function Bridge::BuildTrack()
+{
+	local railtypes = AIRailTypeList();
+	AIRail.SetCurrentRailType(railtypes.Begin());
+
+	for (local x = WEST_X; x <= EAST_X; x++) {
+		if (x >= BRIDGE_WEST_X && x <= BRIDGE_EAST_X) continue;
+		if (!AIRail.BuildRailTrack(AIMap.GetTileIndex(x, TRACK_Y), AIRail.RAILTRACK_NE_SW)) {
+			print("  BuildRailTrack(" + x + "): false");
+		}
+	}
+
+	local bridges = AIBridgeList_Length(BRIDGE_EAST_X - BRIDGE_WEST_X + 1);
+	bridges.Valuate(AIBridge.GetMaxSpeed);
+	bridges.Sort(AIList.SORT_BY_VALUE, AIList.SORT_DESCENDING);
+	print("  BuildBridge():           " + AIBridge.BuildBridge(AIVehicle.VT_RAIL, bridges.Begin(), AIMap.GetTileIndex(BRIDGE_WEST_X, TRACK_Y), AIMap.GetTileIndex(BRIDGE_EAST_X, TRACK_Y)));
+
+	this.west_depot = AIMap.GetTileIndex(WEST_X - 1, TRACK_Y);
+	this.east_depot = AIMap.GetTileIndex(EAST_X + 1, TRACK_Y);
+	print("  BuildRailDepot(west):    " + AIRail.BuildRailDepot(this.west_depot, AIMap.GetTileIndex(WEST_X, TRACK_Y)));
+	print("  BuildRailDepot(east):    " + AIRail.BuildRailDepot(this.east_depot, AIMap.GetTileIndex(EAST_X, TRACK_Y)));
+}
+
+function Bridge::BuildTrain()
+{
+	local engines = AIEngineList(AIVehicle.VT_RAIL);
+	engines.Valuate(AIEngine.IsWagon);
+	engines.KeepValue(0);
+	engines.Valuate(AIEngine.CanRunOnRail, AIRail.GetCurrentRailType());
+	engines.KeepValue(1);
+	engines.Valuate(AIEngine.GetMaxSpeed);
+	engines.Sort(AIList.SORT_BY_VALUE, AIList.SORT_DESCENDING);
+
+	local train = AIVehicle.BuildVehicle(this.west_depot, engines.Begin());
+	print("  BuildVehicle():          " + AIVehicle.IsValidVehicle(train));
+	print("  AppendOrder(east):       " + AIOrder.AppendOrder(train, this.east_depot, AIOrder.OF_NONE));
+	print("  AppendOrder(west):       " + AIOrder.AppendOrder(train, this.west_depot, AIOrder.OF_NONE));
+	print("  StartStopVehicle():      " + AIVehicle.StartStopVehicle(train));
+	return train;
+}
+
+function Bridge::Start()
+{
+	AICompany.SetLoanAmount(AICompany.GetMaxLoanAmount());
+
+	print("");
+	print("--Bridge--");
+	this.PrepareLand();
+	this.BuildTrack();
+	local train = this.BuildTrain();
+
+	/* A train that keeps the slope resistance of the bridge ramp after entering the bridge never reaches its full speed again. */
+	print("  Trips:");
+	for (local i = 0; i < 40; i++) {
+		this.Sleep(100);
+		local tile = AIVehicle.GetLocation(train);
+		print("    " + AIMap.GetTileX(tile) + " => " + AIVehicle.GetCurrentSpeed(train));
+	}
+}
@@ -855,6 +855,34 @@ function Regression::List()
 		it = list.Next();
 		print("    " + it + " => " + list.GetValue(it));
 	}
+
+	list.Clear();
+	for (local i = 0; i < 10; i++) {
+		list.AddItem(i * 2, 100 - i);
+	}
+	list.Sort(AIList.SORT_BY_VALUE, AIList.SORT_ASCENDING);
+	print("  Modify during iteration:");
+	foreach (idx, val in list) {
+		print("    " + idx + " => " + val);
+		if (idx == 18) {
+			list.AddItem(5, 0);
+			list.AddItem(7, 200);
+			list.RemoveItem(14);
+			list.SetValue(16, 95);
+			list.SetValue(12, 1);
+		}
+	}
+	print("  Sort during iteration:");
+	foreach (idx, val in list) {
+		print("    " + idx + " => " + val);
+		if (idx == 18) list.Sort(AIList.SORT_BY_ITEM, AIList.SORT_DESCENDING);
+	}
+	list.Sort(AIList.SORT_BY_VALUE, AIList.SORT_DESCENDING);
+	print("  Valuate during iteration:");
+	foreach (idx, val in list) {
+		print("    " + idx + " => " + val);
+		if (idx == 7) list.Valuate(function (a) { return a; });
+	}
 }
 
 function Regression::Map()
@@ -1018,6 +1046,44 @@ function Regression::Order()
 	}
 }
 
+function Regression::Pathfinder()
+{
+	print("");
+	print("--Pathfinder--");
+	local pf = AIPathfinder(AIPathfinder.PT_ROAD);
+	print("  GetStatus():         " + pf.GetStatus());
+	print("  GetCost():           " + pf.GetCost(AIPathfinder.COST_TILE));
+	print("  GetCost():           " + pf.GetCost(AIPathfinder.COST_END));
+	pf.SetCost(AIPathfinder.COST_TURN, 100000);
+	print("  GetCost():           " + pf.GetCost(AIPathfinder.COST_TURN));
+	print("  FindPath():          " + pf.FindPath(0));
+	print("  GetExploredNodes():  " + pf.GetExploredNodes());
+	print("  FindPath():          " + pf.FindPath(100));
+	print("  GetExploredNodes():  " + pf.GetExploredNodes());
+	print("  GetPath():           " + (pf.GetPath() == null));
+
+	pf = AIPathfinder(AIPathfinder.PT_ROAD);
+	pf.AddStart(33411);
+	pf.AddGoal(33411);
+	print("  FindPath():          " + pf.FindPath(100));
+	print("  GetExploredNodes():  " + pf.GetExploredNodes());
+	local list = pf.GetPath();
+	print("  GetPath():");
+	print("    Count():           " + list.Count());
+	foreach (idx, val in list) {
+		print("    " + idx + " => " + val);
+	}
+
+	/* A single call may not explore more nodes than the script has operations left. */
+	pf = AIPathfinder(AIPathfinder.PT_ROAD);
+	pf.AddStart(AIMap.GetTileIndex(1, 1));
+	pf.AddGoal(AIMap.GetTileIndex(AIMap.GetMapSizeX() - 2, AIMap.GetMapSizeY() - 2));
+	pf.SetMaxNodes(0);
+	local ops = AIController.GetOpsTillSuspend();
+	pf.FindPath(65535);
+	print("  Within ops budget:   " + (pf.GetExploredNodes() <= (ops < 5 ? 1 : ops / 5)));
+}
+
 function Regression::RailTypeList()
 {
 	local list = AIRailTypeList();
@@ -1589,6 +1655,31 @@ function Regression::TileList()
 	for (local i = list.Begin(); !list.IsEnd(); i = list.Next()) {
 		print("    " + i + " => " + list.GetValue(i));
 	}
+
+	local all = AITileList_Attributes.TA_HEIGHT | AITileList_Attributes.TA_SLOPE | AITileList_Attributes.TA_OWNER |
+			AITileList_Attributes.TA_BUILDABLE | AITileList_Attributes.TA_TERRAIN | AITileList_Attributes.TA_TOWN_AUTHORITY;
+	list = AITileList_Attributes(33404 - 256 * 2 - 2, 33404 + 256 * 2 + 2, all);
+	print("");
+	print("--TileList_Attributes--");
+	print("  Count():             " + list.Count());
+	local mismatches = 0;
+	foreach (tile, value in list) {
+		if (AITileList_Attributes.GetAttribute(value, AITileList_Attributes.TA_HEIGHT) != AITile.GetMaxHeight(tile)) mismatches++;
+		if (AITileList_Attributes.GetAttribute(value, AITileList_Attributes.TA_SLOPE) != AITile.GetSlope(tile)) mismatches++;
+		if (AITileList_Attributes.GetAttribute(value, AITileList_Attributes.TA_OWNER) != AITile.GetOwner(tile)) mismatches++;
+		if ((AITileList_Attributes.GetAttribute(value, AITileList_Attributes.TA_BUILDABLE) != 0) != AITile.IsBuildable(tile)) mismatches++;
+		if (AITileList_Attributes.GetAttribute(value, AITileList_Attributes.TA_TERRAIN) != AITile.GetTerrainType(tile)) mismatches++;
+		if (AITileList_Attributes.GetAttribute(value, AITileList_Attributes.TA_TOWN_AUTHORITY) != AITile.GetTownAuthority(tile)) mismatches++;
+	}
+	print("  Mismatches:          " + mismatches);
+	list = AITileList_Attributes(33404, 33404 + 256 + 1, AITileList_Attributes.TA_SLOPE);
+	list.Sort(AIList.SORT_BY_ITEM, AIList.SORT_ASCENDING);
+	print("  Count():             " + list.Count());
+	print("  Height ListDump:");
+	foreach (tile, value in list) {
+		print("    " + tile + " => " + AITileList_Attributes.GetAttribute(value, AITileList_Attributes.TA_HEIGHT));
+	}
+	print("  GetAttribute():      " + AITileList_Attributes.GetAttribute(list.GetValue(33404), all));
 }
 
 function Regression::Town()
@@ -1974,6 +2065,7 @@ function Regression::Start()
 	this.IndustryTypeList();
 	this.Map();
 	this.Marine();
+	this.Pathfinder();
 	this.Prices();
 	this.Rail();
 	this.RailTypeList();
@@ -2015,6 +2107,14 @@ function Regression::Start()
 		}
 	}
 	print("  IsEventWaiting:        false");
+	print("  GetDroppedEventCount:  " + AIEventController.GetDroppedEventCount());
+	print("  IsEventTypeEnabled():  " + AIEventController.IsEventTypeEnabled(AIEvent.ET_VEHICLE_LOST));
+	AIEventController.SetEventTypeEnabled(AIEvent.ET_VEHICLE_LOST, false);
+	print("  SetEventTypeEnabled(): false");
+	print("  IsEventTypeEnabled():  " + AIEventController.IsEventTypeEnabled(AIEvent.ET_VEHICLE_LOST));
+	AIEventController.SetEventTypeEnabled(AIEvent.ET_VEHICLE_LOST, true);
+	print("  SetEventTypeEnabled(): true");
+	print("  IsEventTypeEnabled():  " + AIEventController.IsEventTypeEnabled(AIEvent.ET_VEHICLE_LOST));
 
 	this.Math();
 }
@@ -162,6 +162,7 @@ public:
 	static bool HasAILibrary(const ContentInfo *ci, bool md5sum);
 private:
 	static uint frame_counter;                      ///< Tick counter for the AI code
+	static CompanyID next_company;                  ///< Company whose AI is the first to run in the next tick
 	static class AIScannerInfo *scanner_info;       ///< ScriptScanner instance that is used to find AIs
 	static class AIScannerLibrary *scanner_library; ///< ScriptScanner instance that is used to find AI Libraries
 };
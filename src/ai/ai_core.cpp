@@ -24,6 +24,7 @@
 #include "../safeguards.h"
 
 /* static */ uint AI::frame_counter = 0;
+/* static */ CompanyID AI::next_company = COMPANY_FIRST;
 /* static */ AIScannerInfo *AI::scanner_info = nullptr;
 /* static */ AIScannerLibrary *AI::scanner_library = nullptr;
 
@@ -65,7 +66,7 @@
 	InvalidateWindowData(WC_AI_DEBUG, 0, -1);
 	return;
 }
-size_t previous_index = 0;
+
 /* static */ void AI::GameLoop()
 {
 	/* If we are in networking, only servers run this function, and that only if it is allowed */
@@ -76,36 +77,28 @@ size_t previous_index = 0;
 	assert(_settings_game.difficulty.competitor_speed <= 4);
 	if ((AI::frame_counter & ((1 << (4 - _settings_game.difficulty.competitor_speed)) - 1)) != 0) return;
 
-	size_t current_index = 0;
-	size_t batch_index = 0;
-	size_t full_cycle_iters = std::ceil(Company::GetNumItems()/16.0);
-	if (full_cycle_iters == 0) {
-		full_cycle_iters = 1;
-	}
-	const size_t iterate_per_tick = std::ceil(Company::GetNumItems()/full_cycle_iters);
+	/* With many AI companies there is no time to run all of them every tick.
+	 * Instead they take turns in company order; every tick the next batch runs. */
+	uint batch_size = _settings_game.ai.ai_max_per_tick;
+	if (batch_size == 0) batch_size = MAX_COMPANIES;
 
 	Backup<CompanyID> cur_company(_current_company, FILE_LINE);
-	for (const Company *c : Company::Iterate()) {
-		if (current_index != previous_index) {
-			current_index++;
-			continue;
-		}
+	size_t pool_size = Company::GetPoolSize();
+	for (size_t i = 0; i < pool_size && batch_size > 0; i++) {
+		if (AI::next_company >= pool_size) AI::next_company = COMPANY_FIRST;
+		const Company *c = Company::GetIfValid(AI::next_company++);
+		if (c == nullptr) continue;
+
 		if (c->is_ai) {
 			PerformanceMeasurer framerate((PerformanceElement)(PFE_AI0 + c->index));
 			cur_company.Change(c->index);
 			c->ai_instance->GameLoop();
+			batch_size--;
 		} else {
 			PerformanceMeasurer::SetInactive((PerformanceElement)(PFE_AI0 + c->index));
 		}
-		if (batch_index++ == iterate_per_tick) {
-			break;
-		}
 	}
-	previous_index += batch_index;
 	cur_company.Restore();
-	if (previous_index >= Company::GetNumItems()) {
-		previous_index = 0;
-	}
 
 	/* Occasionally collect garbage; every 255 ticks do one company.
 	 * Effectively collecting garbage once every two months per AI. */
@@ -187,6 +180,7 @@ size_t previous_index = 0;
 	if (AI::scanner_info != nullptr) AI::Uninitialize(true);
 
 	AI::frame_counter = 0;
+	AI::next_company = COMPANY_FIRST;
 	if (AI::scanner_info == nullptr) {
 		TarScanner::DoScan(TarScanner::AI);
 		AI::scanner_info = new AIScannerInfo();
@@ -1123,6 +1123,19 @@ struct AIDebugWindow : public Window {
 		this->last_vscroll_pos = this->vscroll->GetPosition();
 	}
 
+	/**
+	 * Set the string parameters for the memory statistics of a script.
+	 * @param offs     The first string parameter to set.
+	 * @param instance The script to set the statistics of, may be nullptr.
+	 */
+	static void SetMemoryStatsDParams(uint offs, const ScriptInstance *instance)
+	{
+		ScriptMemoryStats stats = instance != nullptr ? instance->GetMemoryStats() : ScriptMemoryStats();
+		SetDParam(offs, stats.live_bytes);
+		SetDParam(offs + 1, stats.peak_bytes);
+		SetDParam(offs + 2, instance != nullptr ? instance->GetAllocationsPerDay() : 0);
+	}
+
 	void SetStringParameters(int widget) const override
 	{
 		switch (widget) {
@@ -1130,17 +1143,20 @@ struct AIDebugWindow : public Window {
 				if (ai_debug_company == OWNER_DEITY) {
 					const GameInfo *info = Game::GetInfo();
 					assert(info != nullptr);
-					SetDParam(0, STR_AI_DEBUG_NAME_AND_VERSION);
+					SetDParam(0, STR_AI_DEBUG_NAME_VERSION_AND_MEMORY);
 					SetDParamStr(1, info->GetName());
 					SetDParam(2, info->GetVersion());
+					SetMemoryStatsDParams(3, Game::GetInstance());
 				} else if (ai_debug_company == INVALID_COMPANY || !Company::IsValidAiID(ai_debug_company)) {
 					SetDParam(0, STR_EMPTY);
 				} else {
-					const AIInfo *info = Company::Get(ai_debug_company)->ai_info;
+					const Company *c = Company::Get(ai_debug_company);
+					const AIInfo *info = c->ai_info;
 					assert(info != nullptr);
-					SetDParam(0, STR_AI_DEBUG_NAME_AND_VERSION);
+					SetDParam(0, STR_AI_DEBUG_NAME_VERSION_AND_MEMORY);
 					SetDParamStr(1, info->GetName());
 					SetDParam(2, info->GetVersion());
+					SetMemoryStatsDParams(3, c->ai_instance);
 				}
 				break;
 		}
@@ -1284,6 +1300,12 @@ struct AIDebugWindow : public Window {
 		}
 	}
 
+	void OnHundredthTick() override
+	{
+		/* The memory statistics of the script keep changing. */
+		this->SetWidgetDirty(WID_AID_NAME_TEXT);
+	}
+
 	/**
 	 * Some data on this window has become invalid.
 	 * @param data Information about the changed data.
@@ -14,23 +14,37 @@
 #include "viewport_func.h"
 #include "framerate_type.h"
 
+#include <unordered_map>
+
 #include "safeguards.h"
 
-/** The table/list with animated tiles. */
+/**
+ * The table/list with animated tiles. Removed tiles are replaced by
+ * INVALID_TILE, so the order of the others does not change, until the
+ * list is compacted.
+ */
 std::vector<TileIndex> _animated_tiles;
 
+/** Position of every animated tile in the list with animated tiles. */
+static std::unordered_map<uint32, size_t> _animated_tile_index;
+
+/** Position of the first removed tile in the list, or SIZE_MAX when there is none. */
+static size_t _first_removed_animated_tile = SIZE_MAX;
+
 /**
  * Removes the given tile from the animated tile table.
  * @param tile the tile to remove
  */
 void DeleteAnimatedTile(TileIndex tile)
 {
-	auto to_remove = std::find(_animated_tiles.begin(), _animated_tiles.end(), tile);
-	if (to_remove != _animated_tiles.end()) {
-		/* The order of the remaining elements must stay the same, otherwise the animation loop may miss a tile. */
-		_animated_tiles.erase(to_remove);
-		MarkTileDirtyByTile(tile);
-	}
+	auto it = _animated_tile_index.find(static_cast<uint32>(tile));
+	if (it == _animated_tile_index.end()) return;
+
+	/* The order of the remaining elements must stay the same, otherwise the animation loop may miss a tile. */
+	_animated_tiles[it->second] = INVALID_TILE;
+	_first_removed_animated_tile = std::min(_first_removed_animated_tile, it->second);
+	_animated_tile_index.erase(it);
+	MarkTileDirtyByTile(tile);
 }
 
 /**
@@ -41,7 +55,47 @@ void DeleteAnimatedTile(TileIndex tile)
 void AddAnimatedTile(TileIndex tile)
 {
 	MarkTileDirtyByTile(tile);
-	include(_animated_tiles, tile);
+	if (_animated_tile_index.emplace(static_cast<uint32>(tile), _animated_tiles.size()).second) _animated_tiles.push_back(tile);
+}
+
+/**
+ * Remove the deleted tiles from the animated tile table, keeping the
+ * order of the remaining tiles.
+ */
+void CompactAnimatedTiles()
+{
+	if (_first_removed_animated_tile == SIZE_MAX) return;
+
+	size_t pos = _first_removed_animated_tile;
+	for (size_t i = pos; i < _animated_tiles.size(); i++) {
+		TileIndex tile = _animated_tiles[i];
+		if (tile == INVALID_TILE) continue;
+
+		_animated_tiles[pos] = tile;
+		_animated_tile_index[static_cast<uint32>(tile)] = pos;
+		pos++;
+	}
+	_animated_tiles.resize(pos);
+	_first_removed_animated_tile = SIZE_MAX;
+}
+
+/**
+ * Rebuild the positions of the animated tiles after the table has been
+ * filled directly, like when loading a savegame. Duplicates are removed.
+ */
+void RebuildAnimatedTileIndex()
+{
+	_animated_tile_index.clear();
+	_first_removed_animated_tile = SIZE_MAX;
+
+	for (size_t i = 0; i < _animated_tiles.size(); i++) {
+		if (_animated_tiles[i] != INVALID_TILE && _animated_tile_index.emplace(static_cast<uint32>(_animated_tiles[i]), i).second) continue;
+
+		_animated_tiles[i] = INVALID_TILE;
+		_first_removed_animated_tile = std::min(_first_removed_animated_tile, i);
+	}
+
+	CompactAnimatedTiles();
 }
 
 /**
@@ -51,21 +105,14 @@ void AnimateAnimatedTiles()
 {
 	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
 
-	const TileIndex *ti = _animated_tiles.data();
-	while (ti < _animated_tiles.data() + _animated_tiles.size()) {
-		const TileIndex curr = *ti;
-		AnimateTile(curr);
-		/* During the AnimateTile call, DeleteAnimatedTile could have been called,
-		 * deleting an element we've already processed and pushing the rest one
-		 * slot to the left. We can detect this by checking whether the index
-		 * in the current slot has changed - if it has, an element has been deleted,
-		 * and we should process the current slot again instead of going forward.
-		 * NOTE: this will still break if more than one animated tile is being
-		 *       deleted during the same AnimateTile call, but no code seems to
-		 *       be doing this anyway.
-		 */
-		if (*ti == curr) ++ti;
+	/* Tiles added during the loop are appended, and get animated as well. Tiles
+	 * deleted during the loop only leave a hole, so nothing shifts under us. */
+	for (size_t i = 0; i < _animated_tiles.size(); i++) {
+		const TileIndex curr = _animated_tiles[i];
+		if (curr != INVALID_TILE) AnimateTile(curr);
 	}
+
+	CompactAnimatedTiles();
 }
 
 /**
@@ -74,4 +121,6 @@ void AnimateAnimatedTiles()
 void InitializeAnimatedTiles()
 {
 	_animated_tiles.clear();
+	_animated_tile_index.clear();
+	_first_removed_animated_tile = SIZE_MAX;
 }
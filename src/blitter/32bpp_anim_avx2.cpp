@@ -0,0 +1,76 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file 32bpp_anim_avx2.cpp Implementation of the AVX2 32 bpp blitter with animation support. */
+
+#ifdef WITH_SSE
+
+#include "../stdafx.h"
+#include "../video/video_driver.hpp"
+#include "../table/sprites.h"
+#include "32bpp_anim_avx2.hpp"
+#include "32bpp_avx2_func.hpp"
+
+#include "../safeguards.h"
+
+/** Instantiation of the AVX2 32bpp blitter factory. */
+static FBlitter_32bppAVX2_Anim iFBlitter_32bppAVX2_Anim;
+
+/**
+ * Draws a sprite to a (screen) buffer. Calls adequate templated function.
+ *
+ * @param bp further blitting parameters
+ * @param mode blitter mode
+ * @param zoom zoom level at which we are drawing
+ */
+void Blitter_32bppAVX2_Anim::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom)
+{
+	if (_screen_disable_anim) {
+		/* This means our output is not to the screen, so we can't be doing any animation stuff, so use our parent Draw() */
+		Blitter_32bppSSE4_Anim::Draw(bp, mode, zoom);
+		return;
+	}
+
+	uint16 *anim_line = this->anim_buf + this->ScreenToAnimOffset((uint32 *)bp->dst) + bp->top * this->anim_buf_pitch + bp->left;
+	const int anim_pitch = this->anim_buf_pitch;
+
+	const Blitter_32bppSSE_Base::SpriteFlags sprite_flags = ((const Blitter_32bppSSE_Base::SpriteData *) bp->sprite)->flags;
+	switch (mode) {
+		default:
+bm_normal:
+			if (!(sprite_flags & SF_NO_ANIM)) break;
+			if (bp->skip_left != 0 || bp->width <= MARGIN_NORMAL_THRESHOLD) {
+				DrawAVX2<BM_NORMAL, RM_WITH_SKIP, true, true>(this, bp, zoom, anim_line, anim_pitch);
+			} else if (sprite_flags & SF_TRANSLUCENT) {
+				DrawAVX2<BM_NORMAL, RM_WITH_MARGIN, true, true>(this, bp, zoom, anim_line, anim_pitch);
+			} else {
+				DrawAVX2<BM_NORMAL, RM_WITH_MARGIN, false, true>(this, bp, zoom, anim_line, anim_pitch);
+			}
+			return;
+
+		case BM_COLOUR_REMAP:
+			if (sprite_flags & SF_NO_REMAP) goto bm_normal;
+			if (!(sprite_flags & SF_NO_ANIM)) break;
+			if (bp->skip_left != 0 || bp->width <= MARGIN_REMAP_THRESHOLD) {
+				DrawAVX2<BM_COLOUR_REMAP, RM_WITH_SKIP, true, true>(this, bp, zoom, anim_line, anim_pitch);
+			} else {
+				DrawAVX2<BM_COLOUR_REMAP, RM_WITH_MARGIN, true, true>(this, bp, zoom, anim_line, anim_pitch);
+			}
+			return;
+
+		case BM_TRANSPARENT: DrawAVX2<BM_TRANSPARENT, RM_NONE, true, true>(this, bp, zoom, anim_line, anim_pitch); return;
+
+		case BM_CRASH_REMAP:
+		case BM_BLACK_REMAP:
+			break;
+	}
+
+	/* Palette animated sprites and the rarely used modes. */
+	Blitter_32bppSSE4_Anim::Draw(bp, mode, zoom);
+}
+
+#endif /* WITH_SSE */
@@ -31,8 +31,11 @@
 #undef MARGIN_NORMAL_THRESHOLD
 #define MARGIN_NORMAL_THRESHOLD 4
 
-/** The SSE4 32 bpp blitter with palette animation. */
-class Blitter_32bppSSE4_Anim FINAL : public Blitter_32bppSSE2_Anim, public Blitter_32bppSSE4 {
+/**
+ * The SSE4 32 bpp blitter with palette animation.
+ * Not final, as the AVX2 blitter with palette animation falls back to it for the modes it does not handle itself.
+ */
+class Blitter_32bppSSE4_Anim : public Blitter_32bppSSE2_Anim, public Blitter_32bppSSE4 {
 private:
 
 public:
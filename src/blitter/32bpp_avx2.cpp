@@ -0,0 +1,64 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file 32bpp_avx2.cpp Implementation of the AVX2 32 bpp blitter. */
+
+#ifdef WITH_SSE
+
+#include "../stdafx.h"
+#include "../zoom_func.h"
+#include "../settings_type.h"
+#include "32bpp_avx2.hpp"
+#include "32bpp_avx2_func.hpp"
+
+#include "../safeguards.h"
+
+/** Instantiation of the AVX2 32bpp blitter factory. */
+static FBlitter_32bppAVX2 iFBlitter_32bppAVX2;
+
+/**
+ * Draws a sprite to a (screen) buffer. Calls adequate templated function.
+ *
+ * @param bp further blitting parameters
+ * @param mode blitter mode
+ * @param zoom zoom level at which we are drawing
+ */
+void Blitter_32bppAVX2::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom)
+{
+	const Blitter_32bppSSE_Base::SpriteFlags sprite_flags = ((const Blitter_32bppSSE_Base::SpriteData *) bp->sprite)->flags;
+	switch (mode) {
+		default:
+bm_normal:
+			if (bp->skip_left != 0 || bp->width <= MARGIN_NORMAL_THRESHOLD) {
+				DrawAVX2<BM_NORMAL, RM_WITH_SKIP, true, false>(this, bp, zoom, nullptr, 0);
+			} else if (sprite_flags & SF_TRANSLUCENT) {
+				DrawAVX2<BM_NORMAL, RM_WITH_MARGIN, true, false>(this, bp, zoom, nullptr, 0);
+			} else {
+				DrawAVX2<BM_NORMAL, RM_WITH_MARGIN, false, false>(this, bp, zoom, nullptr, 0);
+			}
+			return;
+
+		case BM_COLOUR_REMAP:
+			if (sprite_flags & SF_NO_REMAP) goto bm_normal;
+			if (bp->skip_left != 0 || bp->width <= MARGIN_REMAP_THRESHOLD) {
+				DrawAVX2<BM_COLOUR_REMAP, RM_WITH_SKIP, true, false>(this, bp, zoom, nullptr, 0);
+			} else {
+				DrawAVX2<BM_COLOUR_REMAP, RM_WITH_MARGIN, true, false>(this, bp, zoom, nullptr, 0);
+			}
+			return;
+
+		case BM_TRANSPARENT: DrawAVX2<BM_TRANSPARENT, RM_NONE, true, false>(this, bp, zoom, nullptr, 0); return;
+
+		/* Rarely used; not worth vectorising. */
+		case BM_CRASH_REMAP:
+		case BM_BLACK_REMAP:
+			Blitter_32bppSSE4::Draw(bp, mode, zoom);
+			return;
+	}
+}
+
+#endif /* WITH_SSE */
@@ -0,0 +1,303 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file 32bpp_avx2_func.hpp Functions related to AVX2 32 bpp blitter. */
+
+#ifndef BLITTER_32BPP_AVX2_FUNC_HPP
+#define BLITTER_32BPP_AVX2_FUNC_HPP
+
+#ifdef WITH_SSE
+
+#include "32bpp_sse_func.hpp"
+
+/* The SSE masks, repeated for both 128 bit lanes; the AVX2 byte shuffles and packs work per lane. */
+#define CLEAR_HIGH_BYTE_MASK_256 _mm256_setr_epi8(-1,  0, -1,  0, -1,  0, -1,  0, -1,  0, -1,  0, -1,  0, -1,  0, \
+                                                  -1,  0, -1,  0, -1,  0, -1,  0, -1,  0, -1,  0, -1,  0, -1,  0)
+#define ALPHA_CONTROL_MASK_256   _mm256_setr_epi8( 6,  7,  6,  7,  6,  7, -1, -1, 14, 15, 14, 15, 14, 15, -1, -1, \
+                                                   6,  7,  6,  7,  6,  7, -1, -1, 14, 15, 14, 15, 14, 15, -1, -1)
+#define TRANSPARENT_NOM_BASE_256 _mm256_set1_epi16(256)
+#define ALPHA_AND_MASK_256       _mm256_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1)
+#define ALPHA_CHANNEL_MASK_256   _mm256_set1_epi32(0xFF000000)
+
+/**
+ * Get the mask for loading or storing the first pixels of a block of eight.
+ * @param count Number of pixels to load or store; less than eight.
+ * @return Mask with all bits set for the first \a count pixels.
+ */
+GNU_TARGET("avx2")
+static inline __m256i TailMaskAVX2(uint count)
+{
+	return _mm256_cmpgt_epi32(_mm256_set1_epi32(count), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+/**
+ * Get a mask of the pixels that are fully transparent.
+ * @param src Eight pixels.
+ * @return Mask with all bits set for the pixels with an alpha of 0.
+ */
+GNU_TARGET("avx2")
+static inline __m256i TransparentMaskAVX2(__m256i src)
+{
+	return _mm256_cmpeq_epi32(_mm256_and_si256(src, ALPHA_CHANNEL_MASK_256), _mm256_setzero_si256());
+}
+
+/**
+ * Alpha blend eight pixels; the same computation as AlphaBlendTwoPixels.
+ * Unpacking and packing within the 128 bit lanes keeps the pixels in order.
+ */
+GNU_TARGET("avx2")
+static inline __m256i AlphaBlendEightPixels(__m256i src, __m256i dst, const __m256i &alpha_control_mask, const __m256i &clear_high_mask, const __m256i &alpha_and_mask)
+{
+	__m256i srcAB = _mm256_unpacklo_epi8(src, _mm256_setzero_si256());
+	__m256i srcCD = _mm256_unpackhi_epi8(src, _mm256_setzero_si256());
+	__m256i dstAB = _mm256_unpacklo_epi8(dst, _mm256_setzero_si256());
+	__m256i dstCD = _mm256_unpackhi_epi8(dst, _mm256_setzero_si256());
+
+	__m256i alphaMaskAB = _mm256_cmpgt_epi16(srcAB, _mm256_setzero_si256());
+	__m256i alphaMaskCD = _mm256_cmpgt_epi16(srcCD, _mm256_setzero_si256());
+	__m256i alphaAB = _mm256_shuffle_epi8(_mm256_sub_epi16(srcAB, alphaMaskAB), alpha_control_mask);
+	__m256i alphaCD = _mm256_shuffle_epi8(_mm256_sub_epi16(srcCD, alphaMaskCD), alpha_control_mask);
+
+	srcAB = _mm256_add_epi16(_mm256_srli_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(srcAB, dstAB), alphaAB), 8), dstAB);
+	srcCD = _mm256_add_epi16(_mm256_srli_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(srcCD, dstCD), alphaCD), 8), dstCD);
+
+	srcAB = _mm256_or_si256(srcAB, _mm256_and_si256(alphaMaskAB, alpha_and_mask));
+	srcCD = _mm256_or_si256(srcCD, _mm256_and_si256(alphaMaskCD, alpha_and_mask));
+
+	/* Only the low bytes are valid; wipe the high bytes so packing does not saturate. */
+	return _mm256_packus_epi16(_mm256_and_si256(srcAB, clear_high_mask), _mm256_and_si256(srcCD, clear_high_mask));
+}
+
+/** Darken eight pixels; the same computation as DarkenTwoPixels. */
+GNU_TARGET("avx2")
+static inline __m256i DarkenEightPixels(__m256i src, __m256i dst, const __m256i &alpha_control_mask, const __m256i &tr_nom_base)
+{
+	__m256i srcAB = _mm256_unpacklo_epi8(src, _mm256_setzero_si256());
+	__m256i srcCD = _mm256_unpackhi_epi8(src, _mm256_setzero_si256());
+	__m256i dstAB = _mm256_unpacklo_epi8(dst, _mm256_setzero_si256());
+	__m256i dstCD = _mm256_unpackhi_epi8(dst, _mm256_setzero_si256());
+
+	__m256i nomAB = _mm256_sub_epi16(tr_nom_base, _mm256_srli_epi16(_mm256_shuffle_epi8(srcAB, alpha_control_mask), 2));
+	__m256i nomCD = _mm256_sub_epi16(tr_nom_base, _mm256_srli_epi16(_mm256_shuffle_epi8(srcCD, alpha_control_mask), 2));
+	dstAB = _mm256_srli_epi16(_mm256_mullo_epi16(dstAB, nomAB), 8);
+	dstCD = _mm256_srli_epi16(_mm256_mullo_epi16(dstCD, nomCD), 8);
+
+	return _mm256_packus_epi16(dstAB, dstCD);
+}
+
+/**
+ * Clear the animation buffer for the pixels that are not fully transparent.
+ * @param anim Animation buffer of eight pixels.
+ * @param transparent_mask Mask of the fully transparent pixels, see TransparentMaskAVX2.
+ */
+GNU_TARGET("avx2")
+static inline void ClearAnimEightPixels(uint16 *anim, __m256i transparent_mask)
+{
+	__m128i keep = _mm_packs_epi32(_mm256_castsi256_si128(transparent_mask), _mm256_extracti128_si256(transparent_mask, 1));
+	_mm_storeu_si128((__m128i *) anim, _mm_and_si128(_mm_loadu_si128((const __m128i *) anim), keep));
+}
+
+/**
+ * Draws a sprite to a (screen) buffer, eight pixels at a time. It is templated to allow faster operation.
+ * Palette animated pixels are not handled; the animation buffer, if any, is cleared where the sprite is drawn.
+ *
+ * @tparam mode blitter mode: BM_NORMAL, BM_COLOUR_REMAP or BM_TRANSPARENT
+ * @tparam clear_anim whether to clear \a anim_line
+ * @param blitter the blitter to look up colours with
+ * @param bp further blitting parameters
+ * @param zoom zoom level at which we are drawing
+ * @param anim_line the animation buffer at the top left of the area to draw, if \a clear_anim
+ * @param anim_pitch the pitch of the animation buffer
+ */
+IGNORE_UNINITIALIZED_WARNING_START
+template <BlitterMode mode, Blitter_32bppSSE_Base::ReadMode read_mode, bool translucent, bool clear_anim, class T>
+GNU_TARGET("avx2")
+static void DrawAVX2(T *blitter, const Blitter::BlitterParams *bp, ZoomLevel zoom, uint16 *anim_line, int anim_pitch)
+{
+	typedef Blitter_32bppSSE_Base::MapValue MapValue;
+
+	const byte * const remap = bp->remap;
+	Colour *dst_line = (Colour *) bp->dst + bp->top * bp->pitch + bp->left;
+	int effective_width = bp->width;
+
+	/* Find where to start reading in the source sprite. */
+	const Blitter_32bppSSE_Base::SpriteData * const sd = (const Blitter_32bppSSE_Base::SpriteData *) bp->sprite;
+	const Blitter_32bppSSE_Base::SpriteInfo * const si = &sd->infos[zoom];
+	const MapValue *src_mv_line = (const MapValue *) &sd->data[si->mv_offset] + bp->skip_top * si->sprite_width;
+	const Colour *src_rgba_line = (const Colour *) ((const byte *) &sd->data[si->sprite_offset] + bp->skip_top * si->sprite_line_size);
+
+	if (read_mode != Blitter_32bppSSE_Base::RM_WITH_MARGIN) {
+		src_rgba_line += bp->skip_left;
+		src_mv_line += bp->skip_left;
+	}
+
+	/* Load these variables into register before loop. */
+	const __m256i a_cm        = ALPHA_CONTROL_MASK_256;
+	const __m256i clear_hi    = CLEAR_HIGH_BYTE_MASK_256;
+	const __m256i a_am        = ALPHA_AND_MASK_256;
+	const __m256i tr_nom_base = TRANSPARENT_NOM_BASE_256;
+	const __m128i a_cm_128        = ALPHA_CONTROL_MASK;
+	const __m128i pack_low_cm_128 = PACK_LOW_CONTROL_MASK;
+	const __m128i a_am_128        = ALPHA_AND_MASK;
+
+	for (int y = bp->height; y != 0; y--) {
+		Colour *dst = dst_line;
+		const Colour *src = src_rgba_line + META_LENGTH;
+		const MapValue *src_mv = src_mv_line;
+		uint16 *anim = anim_line;
+
+		if (read_mode == Blitter_32bppSSE_Base::RM_WITH_MARGIN) {
+			src += src_rgba_line[0].data;
+			dst += src_rgba_line[0].data;
+			src_mv += src_rgba_line[0].data;
+			if (clear_anim) anim += src_rgba_line[0].data;
+			const int width_diff = si->sprite_width - bp->width;
+			effective_width = bp->width - (int) src_rgba_line[0].data;
+			const int delta_diff = (int) src_rgba_line[1].data - width_diff;
+			const int new_width = effective_width - delta_diff;
+			effective_width = delta_diff > 0 ? new_width : effective_width;
+			if (effective_width <= 0) goto next_line;
+		}
+
+		switch (mode) {
+			default: {
+				for (uint x = (uint) effective_width / 8; x > 0; x--) {
+					__m256i srcABCD = _mm256_loadu_si256((const __m256i *) src);
+					__m256i dstABCD = _mm256_loadu_si256((const __m256i *) dst);
+					__m256i transparent = TransparentMaskAVX2(srcABCD);
+					if (translucent) {
+						_mm256_storeu_si256((__m256i *) dst, AlphaBlendEightPixels(srcABCD, dstABCD, a_cm, clear_hi, a_am));
+					} else {
+						_mm256_storeu_si256((__m256i *) dst, _mm256_blendv_epi8(srcABCD, dstABCD, transparent));
+					}
+					if (clear_anim) ClearAnimEightPixels(anim, transparent);
+					src += 8;
+					dst += 8;
+					anim += 8;
+				}
+
+				const uint tail = (uint) effective_width & 7;
+				if (tail != 0) {
+					const __m256i tail_mask = TailMaskAVX2(tail);
+					__m256i srcABCD = _mm256_maskload_epi32((const int *) src, tail_mask);
+					__m256i dstABCD = _mm256_maskload_epi32((const int *) dst, tail_mask);
+					if (translucent) {
+						_mm256_maskstore_epi32((int *) dst, tail_mask, AlphaBlendEightPixels(srcABCD, dstABCD, a_cm, clear_hi, a_am));
+					} else {
+						_mm256_maskstore_epi32((int *) dst, tail_mask, _mm256_blendv_epi8(srcABCD, dstABCD, TransparentMaskAVX2(srcABCD)));
+					}
+					if (clear_anim) {
+						for (uint i = 0; i < tail; i++) {
+							if (src[i].a) anim[i] = 0;
+						}
+					}
+				}
+				break;
+			}
+
+			case BM_COLOUR_REMAP: {
+				for (uint x = (uint) effective_width / 8; x > 0; x--) {
+					__m256i srcABCD = _mm256_loadu_si256((const __m256i *) src);
+					__m256i dstABCD = _mm256_loadu_si256((const __m256i *) dst);
+					if (clear_anim) ClearAnimEightPixels(anim, TransparentMaskAVX2(srcABCD));
+
+					/* Remap colours; only when any of the eight pixels has a remap channel. */
+					if (!_mm_testz_si128(_mm_loadu_si128((const __m128i *) src_mv), _mm_set1_epi16(0x00FF))) {
+						ALIGN(32) uint32 remapped_src[8];
+						_mm256_store_si256((__m256i *) remapped_src, srcABCD);
+						for (uint i = 0; i < 8; i += 2) {
+							const uint32 mvX2 = *((const uint32 *) &src_mv[i]);
+							if ((mvX2 & 0x00FF00FF) == 0) continue;
+
+							for (uint j = i; j < i + 2; j++) {
+								const uint m = src_mv[j].m;
+								if (m == 0) continue;
+								const uint r = remap[m];
+								remapped_src[j] = r == 0 ? 0 : (blitter->LookupColourInPalette(r).data & 0x00FFFFFF) | (remapped_src[j] & 0xFF000000);
+							}
+							if ((mvX2 & 0xFF00FF00) != 0x80008000) {
+								__m128i srcAB = _mm_loadl_epi64((const __m128i *) &remapped_src[i]);
+								_mm_storel_epi64((__m128i *) &remapped_src[i], AdjustBrightnessOfTwoPixels(srcAB, mvX2));
+							}
+						}
+						srcABCD = _mm256_load_si256((const __m256i *) remapped_src);
+					}
+
+					/* Blend colours. */
+					_mm256_storeu_si256((__m256i *) dst, AlphaBlendEightPixels(srcABCD, dstABCD, a_cm, clear_hi, a_am));
+					src_mv += 8;
+					src += 8;
+					dst += 8;
+					anim += 8;
+				}
+
+				for (uint x = (uint) effective_width & 7; x > 0; x--) {
+					/* In case the m-channel is zero, do not remap this pixel in any way. */
+					if (src_mv->m) {
+						const uint r = remap[src_mv->m];
+						if (r != 0) {
+							Colour remapped_colour = AdjustBrightneSSE(blitter->LookupColourInPalette(r), src_mv->v);
+							if (src->a == 255) {
+								*dst = remapped_colour;
+							} else {
+								remapped_colour.a = src->a;
+								dst->data = _mm_cvtsi128_si32(AlphaBlendTwoPixels(_mm_cvtsi32_si128(remapped_colour.data), _mm_cvtsi32_si128(dst->data), a_cm_128, pack_low_cm_128, a_am_128));
+							}
+						}
+					} else if (src->a == 255) {
+						*dst = *src;
+					} else if (src->a != 0) {
+						dst->data = _mm_cvtsi128_si32(AlphaBlendTwoPixels(_mm_cvtsi32_si128(src->data), _mm_cvtsi32_si128(dst->data), a_cm_128, pack_low_cm_128, a_am_128));
+					}
+					if (clear_anim && src->a) *anim = 0;
+					src_mv++;
+					src++;
+					dst++;
+					anim++;
+				}
+				break;
+			}
+
+			case BM_TRANSPARENT: {
+				/* Make the current colour a bit more black, so it looks like this image is transparent. */
+				for (uint x = (uint) bp->width / 8; x > 0; x--) {
+					__m256i srcABCD = _mm256_loadu_si256((const __m256i *) src);
+					__m256i dstABCD = _mm256_loadu_si256((const __m256i *) dst);
+					_mm256_storeu_si256((__m256i *) dst, DarkenEightPixels(srcABCD, dstABCD, a_cm, tr_nom_base));
+					if (clear_anim) ClearAnimEightPixels(anim, TransparentMaskAVX2(srcABCD));
+					src += 8;
+					dst += 8;
+					anim += 8;
+				}
+
+				const uint tail = (uint) bp->width & 7;
+				if (tail != 0) {
+					const __m256i tail_mask = TailMaskAVX2(tail);
+					__m256i srcABCD = _mm256_maskload_epi32((const int *) src, tail_mask);
+					__m256i dstABCD = _mm256_maskload_epi32((const int *) dst, tail_mask);
+					_mm256_maskstore_epi32((int *) dst, tail_mask, DarkenEightPixels(srcABCD, dstABCD, a_cm, tr_nom_base));
+					if (clear_anim) {
+						for (uint i = 0; i < tail; i++) {
+							if (src[i].a) anim[i] = 0;
+						}
+					}
+				}
+				break;
+			}
+		}
+
+next_line:
+		src_mv_line += si->sprite_width;
+		src_rgba_line = (const Colour*) ((const byte*) src_rgba_line + si->sprite_line_size);
+		dst_line += bp->pitch;
+		if (clear_anim) anim_line += anim_pitch;
+	}
+}
+IGNORE_UNINITIALIZED_WARNING_STOP
+
+#endif /* WITH_SSE */
+#endif /* BLITTER_32BPP_AVX2_FUNC_HPP */
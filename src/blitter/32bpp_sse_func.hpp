@@ -195,7 +195,8 @@ static inline __m128i AdjustBrightnessOfTwoPixels(__m128i from, uint32 brightnes
 #endif
 }
 
-#if FULL_ANIMATION == 0
+/* The AVX2 blitters (SSE_VERSION 5) only share the helpers above; they have their own Draw. */
+#if FULL_ANIMATION == 0 && SSE_VERSION <= 4
 /**
  * Draws a sprite to a (screen) buffer. It is templated to allow faster operation.
  *
@@ -475,7 +476,7 @@ bm_normal:
 		case BM_BLACK_REMAP:  Draw<BM_BLACK_REMAP, RM_NONE, BT_NONE, true>(bp, zoom); return;
 	}
 }
-#endif /* FULL_ANIMATION */
+#endif /* FULL_ANIMATION == 0 && SSE_VERSION <= 4 */
 
 #endif /* WITH_SSE */
 #endif /* BLITTER_32BPP_SSE_FUNC_HPP */
@@ -0,0 +1,173 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file benchmark.cpp Measuring the drawing speed of the blitters. */
+
+#include "../stdafx.h"
+#include "../console_func.h"
+#include "../console_type.h"
+#include "../gfx_func.h"
+#include "../core/alloc_func.hpp"
+#include "../core/backup_type.hpp"
+#include "../core/random_func.hpp"
+#include "../spritecache.h"
+#include "factory.hpp"
+
+#include <chrono>
+
+#include "../safeguards.h"
+
+static const uint BENCHMARK_SPRITE_SIZE = 128; ///< Width and height of the sprites of the benchmark.
+static const uint BENCHMARK_BUFFER_SIZE = 256; ///< Width and height in pixels of the buffer the benchmark draws to.
+
+/** The kinds of sprites of the benchmark. */
+enum BenchmarkSpriteType {
+	BST_OPAQUE,      ///< Fully opaque pixels within a tile-like diamond.
+	BST_TRANSLUCENT, ///< Pixels with all kinds of alpha within a tile-like diamond.
+	BST_REMAP,       ///< A third of the pixels in company colours, with varying brightness.
+	BST_END,
+};
+
+/** A test of the benchmark: a sprite drawn with a blitter mode. */
+struct BenchmarkTest {
+	const char *name;           ///< Name of the test.
+	BenchmarkSpriteType sprite; ///< The sprite to draw.
+	BlitterMode mode;           ///< The mode to draw the sprite with.
+};
+
+/** The fixed set of tests every blitter is measured with. */
+static const BenchmarkTest _benchmark_tests[] = {
+	{"opaque",      BST_OPAQUE,      BM_NORMAL},
+	{"translucent", BST_TRANSLUCENT, BM_NORMAL},
+	{"remap",       BST_REMAP,       BM_COLOUR_REMAP},
+	{"transparent", BST_OPAQUE,      BM_TRANSPARENT},
+};
+
+/**
+ * Fill a sprite of the benchmark. The pixels are pseudo random, but the same on every run.
+ * @param type The kind of sprite.
+ * @param[out] pixels The pixels of the sprite.
+ */
+static void MakeBenchmarkSprite(BenchmarkSpriteType type, std::vector<SpriteLoader::CommonPixel> &pixels)
+{
+	Randomizer r;
+	r.SetSeed(type);
+
+	pixels.resize(BENCHMARK_SPRITE_SIZE * BENCHMARK_SPRITE_SIZE);
+	for (uint y = 0; y < BENCHMARK_SPRITE_SIZE; y++) {
+		for (uint x = 0; x < BENCHMARK_SPRITE_SIZE; x++) {
+			SpriteLoader::CommonPixel &px = pixels[y * BENCHMARK_SPRITE_SIZE + x];
+			px = {};
+
+			/* Leave the corners transparent, like most sprites of tiles. */
+			int dx = abs((int)(2 * x) - (int)BENCHMARK_SPRITE_SIZE);
+			int dy = abs((int)(2 * y) - (int)BENCHMARK_SPRITE_SIZE);
+			if (dx + 2 * dy > (int)BENCHMARK_SPRITE_SIZE) continue;
+
+			px.r = r.Next(256);
+			px.g = r.Next(256);
+			px.b = r.Next(256);
+			px.a = type == BST_TRANSLUCENT ? r.Next(256) : 255;
+			px.m = 0;
+			if (type == BST_REMAP && r.Next(3) == 0) {
+				px.m = 0xC6 + r.Next(8);
+				px.r = px.g = px.b = 64 + r.Next(192);
+			}
+		}
+	}
+}
+
+/** Allocator for the encoded sprites of the benchmark. */
+static void *BenchmarkAllocator(size_t size)
+{
+	return MallocT<byte>(size);
+}
+
+/**
+ * Draw a fixed set of sprites with every usable blitter, and print the number of pixels each blitter draws per second.
+ * The blitters draw to a buffer of their own, which acts as the screen meanwhile; the animated blitters
+ * keep their palette animation buffer up to date like they do when drawing the screen, except for
+ * those that use the animation buffer of the video driver.
+ * @param iterations Number of times to draw each sprite.
+ */
+void BenchmarkBlitters(uint iterations)
+{
+	std::vector<SpriteLoader::CommonPixel> pixels[BST_END];
+	for (uint i = 0; i < BST_END; i++) MakeBenchmarkSprite((BenchmarkSpriteType)i, pixels[i]);
+
+	/* Remap company colours to other company colours, so remapping is not a no-op. */
+	byte remap[256];
+	for (uint i = 0; i < lengthof(remap); i++) remap[i] = i;
+	for (uint i = 0xC6; i < 0xCE; i++) remap[i] = i + 0x10;
+
+	std::vector<uint32> buffer(BENCHMARK_BUFFER_SIZE * BENCHMARK_BUFFER_SIZE);
+
+	Backup<DrawPixelInfo> screen(_screen, FILE_LINE);
+	_screen.dst_ptr = buffer.data();
+	_screen.width = BENCHMARK_BUFFER_SIZE;
+	_screen.height = BENCHMARK_BUFFER_SIZE;
+	_screen.pitch = BENCHMARK_BUFFER_SIZE;
+	Backup<bool> disable_anim(_screen_disable_anim, false, FILE_LINE);
+
+	for (BlitterFactory *factory : BlitterFactory::GetUsableBlitterFactories()) {
+		Blitter *blitter = factory->CreateInstance();
+		if (blitter->GetScreenDepth() == 0) {
+			delete blitter;
+			continue;
+		}
+
+		/* Let the animated blitters allocate their animation buffer for our 'screen'. Blitters that use
+		 * the animation buffer of the video driver can not draw to our 'screen' with animation. */
+		blitter->PostResize();
+		_screen_disable_anim = blitter->NeedsAnimationBuffer();
+
+		for (const BenchmarkTest &test : _benchmark_tests) {
+			SpriteLoader::Sprite sprite[ZOOM_LVL_COUNT];
+			sprite[ZOOM_LVL_NORMAL].height = BENCHMARK_SPRITE_SIZE;
+			sprite[ZOOM_LVL_NORMAL].width = BENCHMARK_SPRITE_SIZE;
+			sprite[ZOOM_LVL_NORMAL].x_offs = 0;
+			sprite[ZOOM_LVL_NORMAL].y_offs = 0;
+			/* Font sprites are only encoded at the normal zoom level. */
+			sprite[ZOOM_LVL_NORMAL].type = ST_FONT;
+			sprite[ZOOM_LVL_NORMAL].colours = SCC_RGB | SCC_ALPHA | SCC_PAL;
+			sprite[ZOOM_LVL_NORMAL].data = pixels[test.sprite].data();
+
+			Sprite *encoded = blitter->Encode(sprite, BenchmarkAllocator);
+
+			Blitter::BlitterParams bp;
+			bp.sprite = encoded->data;
+			bp.remap = remap;
+			bp.skip_left = 0;
+			bp.skip_top = 0;
+			bp.width = BENCHMARK_SPRITE_SIZE;
+			bp.height = BENCHMARK_SPRITE_SIZE;
+			bp.sprite_width = BENCHMARK_SPRITE_SIZE;
+			bp.sprite_height = BENCHMARK_SPRITE_SIZE;
+			bp.dst = buffer.data();
+			bp.pitch = BENCHMARK_BUFFER_SIZE;
+
+			auto start = std::chrono::steady_clock::now();
+			for (uint i = 0; i < iterations; i++) {
+				/* Move the sprite around a bit, so the destination is not always aligned the same way. */
+				bp.left = i % (BENCHMARK_BUFFER_SIZE - BENCHMARK_SPRITE_SIZE);
+				bp.top = (i * 7) % (BENCHMARK_BUFFER_SIZE - BENCHMARK_SPRITE_SIZE);
+				blitter->Draw(&bp, test.mode, ZOOM_LVL_NORMAL);
+			}
+			std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+			double pixels_per_second = duration.count() > 0 ? (double)iterations * BENCHMARK_SPRITE_SIZE * BENCHMARK_SPRITE_SIZE / duration.count() : 0;
+			IConsolePrint(CC_DEFAULT, "{:<18} {:<12} {:>10.1f} Mpixels/s", factory->GetName(), test.name, pixels_per_second / 1000000);
+
+			free(encoded);
+		}
+
+		delete blitter;
+	}
+
+	disable_anim.Restore();
+	screen.Restore();
+}
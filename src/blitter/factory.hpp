@@ -15,6 +15,7 @@
 #include "../string_func.h"
 #include "../core/string_compare_type.hpp"
 #include <map>
+#include <vector>
 
 
 /**
@@ -135,6 +136,19 @@ public:
 		return nullptr;
 	}
 
+	/**
+	 * Get the blitter factories that are usable with the current drivers and hardware config.
+	 * @return The usable blitter factories, ordered by name.
+	 */
+	static std::vector<BlitterFactory *> GetUsableBlitterFactories()
+	{
+		std::vector<BlitterFactory *> factories;
+		for (auto &it : GetBlitters()) {
+			if (it.second->IsUsable()) factories.push_back(it.second);
+		}
+		return factories;
+	}
+
 	/**
 	 * Get the current active blitter (always set by calling SelectBlitter).
 	 */
@@ -187,4 +201,6 @@ public:
 extern std::string _ini_blitter;
 extern bool _blitter_autodetected;
 
+void BenchmarkBlitters(uint iterations);
+
 #endif /* BLITTER_FACTORY_HPP */
@@ -34,6 +34,7 @@
 #include "gamelog.h"
 #include "ai/ai.hpp"
 #include "ai/ai_config.hpp"
+#include "ai/ai_instance.hpp"
 #include "newgrf.h"
 #include "newgrf_profiling.h"
 #include "console_func.h"
@@ -41,11 +42,13 @@
 #include "road.h"
 #include "rail.h"
 #include "game/game.hpp"
+#include "game/game_instance.hpp"
 #include "table/strings.h"
 #include "walltime_func.h"
 #include "company_cmd.h"
 #include "misc_cmd.h"
 #include "battle_royale_mode.h"
+#include "blitter/factory.hpp"
 
 #include <sstream>
 
@@ -1398,6 +1401,38 @@ DEF_CONSOLE_CMD(ConStopAI)
 	return true;
 }
 
+/**
+ * Print the memory statistics of a script to the console.
+ * @param name     Name to show for the script.
+ * @param instance The script.
+ */
+static void PrintScriptMemoryStats(const std::string &name, const ScriptInstance *instance)
+{
+	ScriptMemoryStats stats = instance->GetMemoryStats();
+	IConsolePrint(CC_DEFAULT, "{}: {} KiB in use, {} KiB peak, {} KiB pooled, {} allocations/day",
+		name, stats.live_bytes / 1024, stats.peak_bytes / 1024, stats.pooled_bytes / 1024, instance->GetAllocationsPerDay());
+}
+
+DEF_CONSOLE_CMD(ConScriptMemory)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Show the memory usage of the running AIs and Game Script. Usage: 'script_memory'.");
+		return true;
+	}
+
+	if (_game_mode != GM_NORMAL) {
+		IConsolePrint(CC_ERROR, "Scripts only run in a game.");
+		return true;
+	}
+
+	for (const Company *c : Company::Iterate()) {
+		if (c->is_ai && c->ai_instance != nullptr) PrintScriptMemoryStats(fmt::format("Company {:3d}", c->index + 1), c->ai_instance);
+	}
+	if (Game::GetInstance() != nullptr) PrintScriptMemoryStats("Game Script", Game::GetInstance());
+
+	return true;
+}
+
 DEF_CONSOLE_CMD(ConRescanAI)
 {
 	if (argc == 0) {
@@ -1586,6 +1621,72 @@ DEF_CONSOLE_CMD(ConScreenShot)
 	return true;
 }
 
+DEF_CONSOLE_CMD(ConMinimap)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Write a minimap of the whole world with one pixel per tile. Usage: 'minimap [owner | industry | routes | vegetation] [raw] [<filename>]'.");
+		IConsolePrint(CC_HELP, "  'owner' (default) shows the owner of each tile, 'industry' the industries, 'routes' the transport routes and 'vegetation' the ground cover.");
+		IConsolePrint(CC_HELP, "  'raw' writes one palette index per tile, row by row and without any header, instead of using the screenshot format.");
+		IConsolePrint(CC_HELP, "  A filename ending in # will prevent overwriting existing files and will number files counting upwards.");
+		return true;
+	}
+
+	if (argc > 4) return false;
+
+	static const char * const types[] = { "owner", "industry", "routes", "vegetation" };
+	MinimapType type = MMT_OWNER;
+	bool raw = false;
+	std::string name{};
+	uint32 arg_index = 1;
+
+	if (argc > arg_index) {
+		for (uint i = 0; i < lengthof(types); i++) {
+			if (strcmp(argv[arg_index], types[i]) == 0) {
+				type = (MinimapType)i;
+				arg_index += 1;
+				break;
+			}
+		}
+	}
+
+	if (argc > arg_index && strcmp(argv[arg_index], "raw") == 0) {
+		raw = true;
+		arg_index += 1;
+	}
+
+	if (argc > arg_index) {
+		name = argv[arg_index];
+		arg_index += 1;
+	}
+
+	if (argc > arg_index) return false;
+
+	if (!MakeMinimapExport(type, raw, name)) {
+		IConsolePrint(CC_ERROR, "Failed to write the minimap.");
+		return true;
+	}
+
+	IConsolePrint(CC_INFO, "Minimap of {}x{} tiles saved as '{}'.", MapSizeX(), MapSizeY(), _full_screenshot_name);
+	return true;
+}
+
+DEF_CONSOLE_CMD(ConBenchmarkBlitters)
+{
+	if (argc == 0) {
+		IConsolePrint(CC_HELP, "Measure how many pixels per second each usable blitter draws, using a fixed set of sprites. Usage: 'benchmark_blitters [<iterations>]'.");
+		IConsolePrint(CC_HELP, "  Each sprite is drawn <iterations> times, 1000 by default.");
+		return true;
+	}
+
+	if (argc > 2) return false;
+
+	uint32 iterations = 1000;
+	if (argc == 2 && (!GetArgumentInteger(&iterations, argv[1]) || iterations == 0)) return false;
+
+	BenchmarkBlitters(iterations);
+	return true;
+}
+
 DEF_CONSOLE_CMD(ConInfoCmd)
 {
 	if (argc == 0) {
@@ -2231,6 +2332,8 @@ DEF_CONSOLE_CMD(ConNewGRFProfile)
 		IConsolePrint(CC_HELP, "  End profiling and write the collected data to CSV files.");
 		IConsolePrint(CC_HELP, "Usage: 'newgrf_profile abort':");
 		IConsolePrint(CC_HELP, "  End profiling and discard all collected data.");
+		IConsolePrint(CC_HELP, "Usage: 'newgrf_profile optimise [on | off]':");
+		IConsolePrint(CC_HELP, "  Show or set whether variational action 2 chains are resolved with their load-time optimisations, to compare profiles with and without them.");
 		return true;
 	}
 
@@ -2341,6 +2444,21 @@ DEF_CONSOLE_CMD(ConNewGRFProfile)
 		return true;
 	}
 
+	/* "optimise" sub-command */
+	if (strncasecmp(argv[1], "opt", 3) == 0 && argc <= 3) {
+		if (argc == 3) {
+			if (strcasecmp(argv[2], "on") == 0) {
+				_newgrf_optimise_varaction2 = true;
+			} else if (strcasecmp(argv[2], "off") == 0) {
+				_newgrf_optimise_varaction2 = false;
+			} else {
+				return false;
+			}
+		}
+		IConsolePrint(CC_INFO, "Optimised resolving of variational action 2 chains is {}.", _newgrf_optimise_varaction2 ? "on" : "off");
+		return true;
+	}
+
 	return false;
 }
 
@@ -2669,6 +2787,8 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("reset_enginepool",        ConResetEnginePool,  ConHookNoNetwork);
 	IConsole::CmdRegister("return",                  ConReturn);
 	IConsole::CmdRegister("screenshot",              ConScreenShot);
+	IConsole::CmdRegister("minimap",                 ConMinimap);
+	IConsole::CmdRegister("benchmark_blitters",      ConBenchmarkBlitters);
 	IConsole::CmdRegister("script",                  ConScript);
 	IConsole::CmdRegister("zoomto",                  ConZoomToLevel);
 	IConsole::CmdRegister("scrollto",                ConScrollToTile);
@@ -2704,6 +2824,7 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("rescan_ai",               ConRescanAI);
 	IConsole::CmdRegister("start_ai",                ConStartAI);
 	IConsole::CmdRegister("stop_ai",                 ConStopAI);
+	IConsole::CmdRegister("script_memory",           ConScriptMemory);
 
 	IConsole::CmdRegister("list_game",               ConListGame);
 	IConsole::CmdRegister("list_game_libs",          ConListGameLibs);
@@ -19,7 +19,7 @@ uint64 ottd_rdtsc();
 /**
  * Get the CPUID information from the CPU.
  * @param info The retrieved info. All zeros on architectures without CPUID.
- * @param type The information this instruction should retrieve.
+ * @param type The information this instruction should retrieve; the sub-leaf is always 0.
  */
 void ottd_cpuid(int info[4], int type);
 
@@ -32,4 +32,10 @@ void ottd_cpuid(int info[4], int type);
  */
 bool HasCPUIDFlag(uint type, uint index, uint bit);
 
+/**
+ * Check whether the current CPU and OS support AVX2 instructions.
+ * @return True when AVX2 can be used.
+ */
+bool HasCPUAVX2Support();
+
 #endif /* CPU_H */
@@ -87,6 +87,7 @@ void GroundVehicle<T, Type>::CargoChanged()
 		/* Slope steepness is in percent, result in N. */
 		u->gcache.cached_slope_resistance = current_weight * u->GetSlopeSteepness() * 100;
 	}
+	this->UpdateSlopeResistance();
 
 	/* Store consist weight in cache. */
 	this->gcache.cached_weight = std::max(1u, weight);
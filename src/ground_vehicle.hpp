@@ -30,6 +30,7 @@ struct GroundVehicleCache {
 	/* Cached acceleration values, recalculated when the cargo on a vehicle changes (in addition to the conditions below) */
 	uint32 cached_weight;           ///< Total weight of the consist (valid only for the first engine).
 	uint32 cached_slope_resistance; ///< Resistance caused by weight when this vehicle part is at a slope.
+	int64 cached_total_slope_resistance; ///< Resistance caused by the parts of the consist that are at a slope (valid only for the first engine).
 	uint32 cached_max_te;           ///< Maximum tractive effort of consist (valid only for the first engine).
 	uint16 cached_axle_resistance;  ///< Resistance caused by the axles of the vehicle (valid only for the first engine).
 
@@ -104,26 +105,56 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 			ClrBit(v->gv_flags, GVF_GOINGUP_BIT);
 			ClrBit(v->gv_flags, GVF_GOINGDOWN_BIT);
 		}
+		this->First()->UpdateSlopeResistance();
 		return this->Vehicle::Crash(flooded);
 	}
 
 	/**
-	 * Calculates the total slope resistance for this vehicle.
-	 * @return Slope resistance.
+	 * Calculates the slope resistance of this vehicle part alone.
+	 * @return Slope resistance of this part; negative when going down.
 	 */
-	inline int64 GetSlopeResistance() const
+	inline int64 GetPartSlopeResistance() const
+	{
+		if (HasBit(this->gv_flags, GVF_GOINGUP_BIT)) return this->gcache.cached_slope_resistance;
+		if (HasBit(this->gv_flags, GVF_GOINGDOWN_BIT)) return -(int64)this->gcache.cached_slope_resistance;
+		return 0;
+	}
+
+	/**
+	 * Clears the inclination of this vehicle part, e.g. when it enters a bridge or tunnel.
+	 * The total slope resistance of the consist is updated to match.
+	 */
+	inline void ClearInclination()
+	{
+		this->First()->gcache.cached_total_slope_resistance -= this->GetPartSlopeResistance();
+		ClrBit(this->gv_flags, GVF_GOINGUP_BIT);
+		ClrBit(this->gv_flags, GVF_GOINGDOWN_BIT);
+	}
+
+	/**
+	 * Recalculates the cached total slope resistance from all parts of the consist.
+	 * Only needed when the inclination of several parts changes at once, as
+	 * UpdateZPositionAndInclination keeps the total up to date for a single part.
+	 */
+	inline void UpdateSlopeResistance()
 	{
+		assert(this->First() == this);
 		int64 incl = 0;
 
 		for (const T *u = T::From(this); u != nullptr; u = u->Next()) {
-			if (HasBit(u->gv_flags, GVF_GOINGUP_BIT)) {
-				incl += u->gcache.cached_slope_resistance;
-			} else if (HasBit(u->gv_flags, GVF_GOINGDOWN_BIT)) {
-				incl -= u->gcache.cached_slope_resistance;
-			}
+			incl += u->GetPartSlopeResistance();
 		}
 
-		return incl;
+		this->gcache.cached_total_slope_resistance = incl;
+	}
+
+	/**
+	 * Gets the total slope resistance for this vehicle.
+	 * @return Slope resistance.
+	 */
+	inline int64 GetSlopeResistance() const
+	{
+		return this->gcache.cached_total_slope_resistance;
 	}
 
 	/**
@@ -134,6 +165,8 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 	 */
 	inline void UpdateZPositionAndInclination()
 	{
+		int64 old_resistance = this->GetPartSlopeResistance();
+
 		this->z_pos = GetSlopePixelZ(this->x_pos, this->y_pos);
 		ClrBit(this->gv_flags, GVF_GOINGUP_BIT);
 		ClrBit(this->gv_flags, GVF_GOINGDOWN_BIT);
@@ -149,6 +182,9 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 				SetBit(this->gv_flags, (middle_z > this->z_pos) ? GVF_GOINGUP_BIT : GVF_GOINGDOWN_BIT);
 			}
 		}
+
+		/* Keep the total of the consist in sync without walking all its parts. */
+		this->First()->gcache.cached_total_slope_resistance += this->GetPartSlopeResistance() - old_resistance;
 	}
 
 	/**
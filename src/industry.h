@@ -78,7 +78,7 @@ struct Industry : IndustryPool::PoolItem<&_industry_pool> {
 	byte last_month_pct_transported[INDUSTRY_NUM_OUTPUTS]; ///< percentage transported per cargo in the last full month
 	uint16 last_month_production[INDUSTRY_NUM_OUTPUTS];    ///< total units produced per cargo in the last full month
 	uint16 last_month_transported[INDUSTRY_NUM_OUTPUTS];   ///< total units transported per cargo in the last full month
-	uint16 counter;                                        ///< used for animation and/or production (if available cargo)
+	uint16 counter;                                        ///< used for animation and/or production (if available cargo); only valid when saving, see GetCounter()
 
 	IndustryType type;             ///< type of industry.
 	Owner owner;                   ///< owner of the industry.  Which SHOULD always be (imho) OWNER_NONE
@@ -90,6 +90,7 @@ struct Industry : IndustryPool::PoolItem<&_industry_pool> {
 	PartOfSubsidy part_of_subsidy; ///< NOSAVE: is this industry a source/destination of a subsidy?
 	StationList stations_near;     ///< NOSAVE: List of nearby stations.
 	mutable std::string cached_name; ///< NOSAVE: Cache of the resolved name of the industry
+	uint16 counter_base;           ///< NOSAVE: Value of the counter when the industry tick counter was zero, see GetCounter()
 
 	Owner founder;                 ///< Founder of the industry
 	Date construction_date;        ///< Date of the construction of the industry
@@ -108,6 +109,7 @@ struct Industry : IndustryPool::PoolItem<&_industry_pool> {
 	~Industry();
 
 	void RecomputeProductionMultipliers();
+	uint16 GetCounter() const;
 
 	/**
 	 * Check if a given tile belongs to this industry.
@@ -202,6 +204,7 @@ protected:
 };
 
 void ClearAllIndustryCachedNames();
+void RebuildIndustryTickSchedule();
 
 void PlantRandomFarmField(const Industry *i);
 
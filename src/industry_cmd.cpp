@@ -44,6 +44,7 @@
 #include "industry_cmd.h"
 #include "landscape_cmd.h"
 #include "terraform_cmd.h"
+#include "framerate_type.h"
 
 #include "table/strings.h"
 #include "table/industry_land.h"
@@ -60,6 +61,10 @@ void BuildOilRig(TileIndex tile);
 static byte _industry_sound_ctr;
 static TileIndex _industry_sound_tile;
 
+static const uint INDUSTRY_TICK_BUCKETS = 64; ///< Number of buckets industries are spread over by their counter, see OnTick_Industry.
+static uint16 _industry_ticks; ///< Number of industry ticks, wrapping like the industry counters.
+static std::vector<IndustryID> _industry_tick_buckets[INDUSTRY_TICK_BUCKETS]; ///< Industries, sorted by index, per value of the lower bits of their counter base.
+
 uint16 Industry::counts[NUM_INDUSTRYTYPES];
 
 IndustrySpec _industry_specs[NUM_INDUSTRYTYPES];
@@ -140,10 +145,60 @@ const IndustryTileSpec *GetIndustryTileSpec(IndustryGfx gfx)
 	return &_industry_tile_specs[gfx];
 }
 
+/**
+ * Get the bucket of an industry in the tick schedule.
+ * @param i The industry.
+ * @return The bucket the industry is in.
+ */
+static std::vector<IndustryID> &GetIndustryTickBucket(const Industry *i)
+{
+	return _industry_tick_buckets[i->counter_base % INDUSTRY_TICK_BUCKETS];
+}
+
+/**
+ * Add an industry to the tick schedule, based on its counter.
+ * @param i The industry to add.
+ */
+static void ScheduleIndustryTicks(Industry *i)
+{
+	i->counter_base = i->counter + _industry_ticks;
+	std::vector<IndustryID> &bucket = GetIndustryTickBucket(i);
+	bucket.insert(std::lower_bound(bucket.begin(), bucket.end(), i->index), i->index);
+}
+
+/**
+ * Remove an industry from the tick schedule, if it is in there.
+ * @param i The industry to remove.
+ */
+static void UnscheduleIndustryTicks(const Industry *i)
+{
+	std::vector<IndustryID> &bucket = GetIndustryTickBucket(i);
+	auto it = std::lower_bound(bucket.begin(), bucket.end(), i->index);
+	if (it != bucket.end() && *it == i->index) bucket.erase(it);
+}
+
+/** Rebuild the tick schedule from the counters of all industries. */
+void RebuildIndustryTickSchedule()
+{
+	for (auto &bucket : _industry_tick_buckets) bucket.clear();
+	for (Industry *i : Industry::Iterate()) ScheduleIndustryTicks(i);
+}
+
+/**
+ * Get the counter of this industry, which is decremented every industry tick.
+ * @return The counter of the industry.
+ */
+uint16 Industry::GetCounter() const
+{
+	return this->counter_base - _industry_ticks;
+}
+
 Industry::~Industry()
 {
 	if (CleaningPool()) return;
 
+	UnscheduleIndustryTicks(this);
+
 	/* Industry can also be destroyed when not fully initialized.
 	 * This means that we do not have to clear tiles either.
 	 * Also we must not decrement industry counts in that case. */
@@ -1133,8 +1188,11 @@ static void ProduceIndustryGoods(Industry *i)
 {
 	const IndustrySpec *indsp = GetIndustrySpec(i->type);
 
+	/* The counter has already been decremented for this tick. */
+	const uint16 counter = i->GetCounter();
+
 	/* play a sound? */
-	if ((i->counter & 0x3F) == 0) {
+	if (((counter + 1) & 0x3F) == 0) {
 		uint32 r;
 		if (Chance16R(1, 14, r) && indsp->number_of_sounds != 0 && _settings_client.sound.ambient) {
 			for (size_t j = 0; j < lengthof(i->last_month_production); j++) {
@@ -1149,10 +1207,8 @@ static void ProduceIndustryGoods(Industry *i)
 		}
 	}
 
-	i->counter--;
-
 	/* produce some cargo */
-	if ((i->counter % INDUSTRY_PRODUCE_TICKS) == 0) {
+	if ((counter % INDUSTRY_PRODUCE_TICKS) == 0) {
 		if (HasBit(indsp->callback_mask, CBM_IND_PRODUCTION_256_TICKS)) IndustryProductionCallback(i, 1);
 
 		IndustryBehaviour indbehav = indsp->behaviour;
@@ -1185,7 +1241,7 @@ static void ProduceIndustryGoods(Industry *i)
 			if (cb_res != CALLBACK_FAILED) {
 				cut = ConvertBooleanCallback(indsp->grf_prop.grffile, CBID_INDUSTRY_SPECIAL_EFFECT, cb_res);
 			} else {
-				cut = ((i->counter % INDUSTRY_CUT_TREE_TICKS) == 0);
+				cut = ((counter % INDUSTRY_CUT_TREE_TICKS) == 0);
 			}
 
 			if (cut) ChopLumberMillTrees(i);
@@ -1211,8 +1267,22 @@ void OnTick_Industry()
 
 	if (_game_mode == GM_EDITOR) return;
 
-	for (Industry *i : Industry::Iterate()) {
-		ProduceIndustryGoods(i);
+	PerformanceAccumulator framerate(PFE_GL_INDUSTRIES);
+
+	_industry_ticks++;
+
+	/* An industry only does something in the tick after its counter became a multiple of 64,
+	 * or in the tick its counter becomes a multiple of 256. So only visit the industries in
+	 * those two buckets, in the same order as a scan over all industries would. */
+	const std::vector<IndustryID> &sound = _industry_tick_buckets[(_industry_ticks - 1) % INDUSTRY_TICK_BUCKETS];
+	const std::vector<IndustryID> &produce = _industry_tick_buckets[_industry_ticks % INDUSTRY_TICK_BUCKETS];
+
+	static std::vector<IndustryID> due;
+	due.clear();
+	std::merge(sound.begin(), sound.end(), produce.begin(), produce.end(), std::back_inserter(due));
+
+	for (IndustryID index : due) {
+		ProduceIndustryGoods(Industry::Get(index));
 	}
 }
 
@@ -1778,6 +1848,7 @@ static void DoCreateNewIndustry(Industry *i, TileIndex tile, IndustryType type,
 	uint16 r = Random();
 	i->random_colour = GB(r, 0, 4);
 	i->counter = GB(r, 4, 12);
+	ScheduleIndustryTicks(i);
 	i->random = initial_random_bits;
 	i->was_cargo_delivered = false;
 	i->last_prod_year = _cur_year;
@@ -2981,6 +3052,9 @@ void InitializeIndustries()
 	Industry::ResetIndustryCounts();
 	_industry_sound_tile = 0;
 
+	_industry_ticks = 0;
+	for (auto &bucket : _industry_tick_buckets) bucket.clear();
+
 	_industry_builder.Reset();
 }
 
@@ -834,10 +834,17 @@ void RunTileLoop()
 	}
 
 	while (count--) {
+		/* Get the next tile in sequence using a Galois LFSR. */
+		TileIndex next = (tile >> 1) ^ (-(int32)(tile & 1) & feedback);
+
+		/* The sequence jumps all over the map, so nearly every tile is a
+		 * cache miss. Start loading the next one while handling this one. */
+		PREFETCH(&_m[next]);
+		PREFETCH(&_me[next]);
+
 		_tile_type_procs[GetTileType(tile)]->tile_loop_proc(tile);
 
-		/* Get the next tile in sequence using a Galois LFSR. */
-		tile = (tile >> 1) ^ (-(int32)(tile & 1) & feedback);
+		tile = next;
 	}
 
 	_cur_tileloop_tile = tile;
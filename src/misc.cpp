@@ -82,6 +82,7 @@ void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settin
 
 	RebuildStationKdtree();
 	RebuildTownKdtree();
+	RebuildTownGrowthSchedule();
 	RebuildViewportKdtree();
 
 	ResetPersistentNewGRFData();
@@ -5036,6 +5036,45 @@ static const SpriteGroup *CreateGroupFromGroupID(byte feature, byte setid, byte
 	return new ResultSpriteGroup(spriteset_start, num_sprites);
 }
 
+/**
+ * Check whether a vehicle variable only changes when the NewGRF cache of the vehicle is invalidated.
+ * Random bits, position, speed, load and date dependent variables are not in this list.
+ * @param variable The variable of the var adjust.
+ * @return True iff the result of the variable may be cached.
+ */
+static bool IsCacheableVehicleVariable(byte variable)
+{
+	switch (variable) {
+		case 0x03: // Climate
+		case 0x0C: // Callback number
+		case 0x10: // Callback parameter 1
+		case 0x18: // Callback parameter 2
+		case 0x1A: // All ones
+		case 0x1C: // Result of the last var adjust
+		case 0x40: // Position in consist and length, cached in NewGRFCache
+		case 0x41: // Position in same-id chain and length, cached in NewGRFCache
+		case 0x42: // Consist cargo information, cached in NewGRFCache
+		case 0x43: // Company information, cached in NewGRFCache
+		case 0x4D: // Position in articulated vehicle, cached in NewGRFCache
+		case 0x7D: // Temporary storage
+		case 0x7F: // GRF parameter
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * Check whether resolving a (possibly missing) sprite group may be cached.
+ * @param group The sprite group.
+ * @return True iff the group is cacheable.
+ */
+static inline bool IsCacheableGroup(const SpriteGroup *group)
+{
+	return group == nullptr || group->cacheable;
+}
+
 /* Action 0x02 */
 static void NewSpriteGroup(ByteReader *buf)
 {
@@ -5170,6 +5209,22 @@ static void NewSpriteGroup(ByteReader *buf)
 				}
 			}
 
+			group->Optimise();
+
+			/* Only vehicle chains that read nothing but static variables of the vehicle itself are cacheable. */
+			group->cacheable = feature <= GSF_AIRCRAFT && group->var_scope == VSG_SCOPE_SELF && IsCacheableGroup(group->default_group);
+			for (const auto &adjust : group->adjusts) {
+				if (!group->cacheable) break;
+				if (adjust.variable == 0x7E) {
+					group->cacheable = IsCacheableGroup(adjust.subroutine);
+				} else {
+					group->cacheable = IsCacheableVehicleVariable(adjust.variable) && adjust.operation != DSGA_OP_STOP;
+				}
+			}
+			for (const auto &range : group->ranges) {
+				if (!group->cacheable) break;
+				group->cacheable = IsCacheableGroup(range.group);
+			}
 			break;
 		}
 
@@ -5181,6 +5236,7 @@ static void NewSpriteGroup(ByteReader *buf)
 			assert(RandomizedSpriteGroup::CanAllocateItem());
 			RandomizedSpriteGroup *group = new RandomizedSpriteGroup();
 			group->nfo_line = _cur.nfo_line;
+			group->cacheable = false;
 			act_group = group;
 			group->var_scope = HasBit(type, 1) ? VSG_SCOPE_PARENT : VSG_SCOPE_SELF;
 
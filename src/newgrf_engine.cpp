@@ -1183,16 +1183,15 @@ uint16 GetVehicleCallbackParent(CallbackID callback, uint32 param1, uint32 param
 }
 
 
-/* Callback 36 handlers */
-int GetVehicleProperty(const Vehicle *v, PropertyID property, int orig_value, bool is_signed)
-{
-	return GetEngineProperty(v->engine_type, property, orig_value, v, is_signed);
-}
-
-
-int GetEngineProperty(EngineID engine, PropertyID property, int orig_value, const Vehicle *v, bool is_signed)
+/**
+ * Convert the result of callback 36 into a property value.
+ * @param callback The callback result.
+ * @param orig_value The value to use when the callback failed.
+ * @param is_signed Whether the property is a signed 15 bit integer.
+ * @return The property value.
+ */
+static int GetPropertyFromCallbackResult(uint16 callback, int orig_value, bool is_signed)
 {
-	uint16 callback = GetVehicleCallback(CBID_VEHICLE_MODIFY_PROPERTY, property, 0, engine, v);
 	if (callback != CALLBACK_FAILED) {
 		if (is_signed) {
 			/* Sign extend 15 bit integer */
@@ -1205,6 +1204,26 @@ int GetEngineProperty(EngineID engine, PropertyID property, int orig_value, cons
 	return orig_value;
 }
 
+/* Callback 36 handlers */
+int GetVehicleProperty(const Vehicle *v, PropertyID property, int orig_value, bool is_signed)
+{
+	uint16 callback;
+	if (!v->grf_property_cache.Get(property, callback)) {
+		VehicleResolverObject object(v->engine_type, v, VehicleResolverObject::WO_UNCACHED, false, CBID_VEHICLE_MODIFY_PROPERTY, property, 0);
+		callback = object.ResolveCallback();
+		/* Only remember the result when the chain does not depend on anything that can change without invalidating the NewGRF cache. */
+		if (object.root_spritegroup == nullptr || object.root_spritegroup->cacheable) v->grf_property_cache.Set(property, callback);
+	}
+	return GetPropertyFromCallbackResult(callback, orig_value, is_signed);
+}
+
+
+int GetEngineProperty(EngineID engine, PropertyID property, int orig_value, const Vehicle *v, bool is_signed)
+{
+	uint16 callback = GetVehicleCallback(CBID_VEHICLE_MODIFY_PROPERTY, property, 0, engine, v);
+	return GetPropertyFromCallbackResult(callback, orig_value, is_signed);
+}
+
 
 static void DoTriggerVehicle(Vehicle *v, VehicleTrigger trigger, byte base_random_bits, bool first)
 {
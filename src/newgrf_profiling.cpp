@@ -52,6 +52,7 @@ void NewGRFProfiler::BeginResolve(const ResolverObject &resolver)
 	this->cur_call.cb = resolver.callback;
 	this->cur_call.feat = resolver.GetFeature();
 	this->cur_call.item = resolver.GetDebugID();
+	this->cur_call.optimised = _newgrf_optimise_varaction2;
 }
 
 /**
@@ -107,9 +108,9 @@ uint32 NewGRFProfiler::Finish()
 
 	uint32 total_microseconds = 0;
 
-	fputs("Tick,Sprite,Feature,Item,CallbackID,Microseconds,Depth,Result\n", f);
+	fputs("Tick,Sprite,Feature,Item,CallbackID,Microseconds,Depth,Result,Optimised\n", f);
 	for (const Call &c : this->calls) {
-		fprintf(f, OTTD_PRINTF64U ",%u,0x%X,%u,0x%X,%u,%u,%u\n", c.tick, c.root_sprite, c.feat, c.item, (uint)c.cb, c.time, c.subs, c.result);
+		fprintf(f, OTTD_PRINTF64U ",%u,0x%X,%u,0x%X,%u,%u,%u,%u\n", c.tick, c.root_sprite, c.feat, c.item, (uint)c.cb, c.time, c.subs, c.result, (uint)c.optimised);
 		total_microseconds += c.time;
 	}
 
@@ -48,6 +48,7 @@ struct NewGRFProfiler {
 		uint64 tick;         ///< Game tick
 		CallbackID cb;       ///< Callback ID
 		GrfSpecFeature feat; ///< GRF feature being resolved for
+		bool optimised;      ///< Whether the optimised deterministic sprite groups were used
 	};
 
 	const GRFFile *grffile;  ///< Which GRF is being profiled
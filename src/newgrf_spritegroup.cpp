@@ -20,6 +20,9 @@ INSTANTIATE_POOL_METHODS(SpriteGroup)
 
 TemporaryStorageArray<int32, 0x110> _temp_store;
 
+/** Whether deterministic sprite groups are resolved using the data set up by DeterministicSpriteGroup::Optimise, or fully interpreted. */
+bool _newgrf_optimise_varaction2 = true;
+
 
 /**
  * ResolverObject (re)entry point.
@@ -189,14 +192,59 @@ static bool RangeHighComparator(const DeterministicSpriteGroupRange& range, uint
 	return range.high < value;
 }
 
+/** Maximum number of values spanned by the ranges of a group to look up its target in a table. */
+static const uint32 MAX_RANGE_TABLE_SIZE = 64;
+
+/**
+ * Prepare the group for faster resolving, without changing the outcome.
+ * The adjusts at the start of the chain that only work on constants are evaluated once,
+ * and when the ranges are close together a table of the target groups replaces searching the ranges.
+ */
+void DeterministicSpriteGroup::Optimise()
+{
+	this->first_adjust = 0;
+	this->initial_value = 0;
+
+	for (const auto &adjust : this->adjusts) {
+		/* Only variable 1A (always -1) is constant. Storing has side effects, and signed division might trap. */
+		if (adjust.variable != 0x1A || adjust.type != DSGA_TYPE_NONE) break;
+		if (adjust.operation == DSGA_OP_STO || adjust.operation == DSGA_OP_STOP) break;
+		if (adjust.operation == DSGA_OP_SDIV || adjust.operation == DSGA_OP_SMOD) break;
+
+		switch (this->size) {
+			case DSG_SIZE_BYTE:  this->initial_value = EvalAdjustT<uint8,  int8> (adjust, nullptr, this->initial_value, UINT_MAX); break;
+			case DSG_SIZE_WORD:  this->initial_value = EvalAdjustT<uint16, int16>(adjust, nullptr, this->initial_value, UINT_MAX); break;
+			case DSG_SIZE_DWORD: this->initial_value = EvalAdjustT<uint32, int32>(adjust, nullptr, this->initial_value, UINT_MAX); break;
+			default: NOT_REACHED();
+		}
+		this->first_adjust++;
+	}
+
+	this->range_table.clear();
+	if (this->ranges.size() > 2 && this->ranges.back().high - this->ranges.front().low < MAX_RANGE_TABLE_SIZE) {
+		uint32 low = this->ranges.front().low;
+		this->range_table.resize(this->ranges.back().high - low + 1, this->default_group);
+		for (const auto &range : this->ranges) {
+			std::fill(this->range_table.begin() + (range.low - low), this->range_table.begin() + (range.high - low + 1), range.group);
+		}
+	}
+}
+
 const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) const
 {
 	uint32 last_value = 0;
 	uint32 value = 0;
+	uint first_adjust = 0;
+
+	if (_newgrf_optimise_varaction2) {
+		last_value = value = this->initial_value;
+		first_adjust = this->first_adjust;
+	}
 
 	ScopeResolver *scope = object.GetScope(this->var_scope);
 
-	for (const auto &adjust : this->adjusts) {
+	for (auto it = this->adjusts.begin() + first_adjust; it != this->adjusts.end(); ++it) {
+		const DeterministicSpriteGroupAdjust &adjust = *it;
 		/* Try to get the variable. We shall assume it is available, unless told otherwise. */
 		bool available = true;
 		if (adjust.variable == 0x7E) {
@@ -239,6 +287,11 @@ const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) con
 		return &nvarzero;
 	}
 
+	if (_newgrf_optimise_varaction2 && !this->range_table.empty()) {
+		uint32 index = value - this->ranges.front().low;
+		return SpriteGroup::Resolve(index < this->range_table.size() ? this->range_table[index] : this->default_group, object, false);
+	}
+
 	if (this->ranges.size() > 4) {
 		const auto &lower = std::lower_bound(this->ranges.begin(), this->ranges.end(), value, RangeHighComparator);
 		if (lower != this->ranges.end() && lower->low <= value) {
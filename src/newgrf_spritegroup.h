@@ -56,7 +56,7 @@ extern SpriteGroupPool _spritegroup_pool;
 /* Common wrapper for all the different sprite group types */
 struct SpriteGroup : SpriteGroupPool::PoolItem<&_spritegroup_pool> {
 protected:
-	SpriteGroup(SpriteGroupType type) : nfo_line(0), type(type) {}
+	SpriteGroup(SpriteGroupType type) : nfo_line(0), type(type), cacheable(true) {}
 	/** Base sprite group resolver */
 	virtual const SpriteGroup *Resolve(ResolverObject &object) const { return this; };
 
@@ -65,6 +65,7 @@ public:
 
 	uint32 nfo_line;
 	SpriteGroupType type;
+	bool cacheable; ///< Resolving this group only reads variables that are constant until the vehicle's NewGRF cache is invalidated.
 
 	virtual SpriteID GetResult() const { return 0; }
 	virtual byte GetNumResults() const { return 0; }
@@ -178,10 +179,19 @@ struct DeterministicSpriteGroup : SpriteGroup {
 
 	const SpriteGroup *error_group; // was first range, before sorting ranges
 
+	/* Set up by Optimise() once the group is loaded; only used when #_newgrf_optimise_varaction2 is set. */
+	uint first_adjust = 0;                        ///< First adjust to evaluate; the constant adjusts before it are folded into #initial_value.
+	uint32 initial_value = 0;                     ///< Value of the chain after the folded adjusts.
+	std::vector<const SpriteGroup *> range_table; ///< Group for each value from the lowest range onwards, when the ranges only span a few values.
+
+	void Optimise();
+
 protected:
 	const SpriteGroup *Resolve(ResolverObject &object) const;
 };
 
+extern bool _newgrf_optimise_varaction2;
+
 enum RandomizedSpriteGroupCompareMode {
 	RSG_CMP_ANY,
 	RSG_CMP_ALL,
@@ -1226,15 +1226,17 @@ static void CheckCaches()
 		uint length = 0;
 		for (const Vehicle *u = v; u != nullptr; u = u->Next()) length++;
 
-		NewGRFCache        *grf_cache = CallocT<NewGRFCache>(length);
-		VehicleCache       *veh_cache = CallocT<VehicleCache>(length);
-		GroundVehicleCache *gro_cache = CallocT<GroundVehicleCache>(length);
-		TrainCache         *tra_cache = CallocT<TrainCache>(length);
+		NewGRFCache         *grf_cache = CallocT<NewGRFCache>(length);
+		NewGRFPropertyCache *prop_cache = CallocT<NewGRFPropertyCache>(length);
+		VehicleCache        *veh_cache = CallocT<VehicleCache>(length);
+		GroundVehicleCache  *gro_cache = CallocT<GroundVehicleCache>(length);
+		TrainCache          *tra_cache = CallocT<TrainCache>(length);
 
 		length = 0;
 		for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
 			FillNewGRFVehicleCache(u);
 			grf_cache[length] = u->grf_cache;
+			prop_cache[length] = u->grf_property_cache;
 			veh_cache[length] = u->vcache;
 			switch (u->type) {
 				case VEH_TRAIN:
@@ -1264,6 +1266,11 @@ static void CheckCaches()
 			if (memcmp(&grf_cache[length], &u->grf_cache, sizeof(NewGRFCache)) != 0) {
 				Debug(desync, 2, "newgrf cache mismatch: type {}, vehicle {}, company {}, unit number {}, wagon {}", v->type, v->index, v->owner, v->unitnumber, length);
 			}
+			for (uint i = 0; i < prop_cache[length].count; i++) {
+				if (GetVehicleCallback(CBID_VEHICLE_MODIFY_PROPERTY, prop_cache[length].property[i], 0, u->engine_type, u) != prop_cache[length].value[i]) {
+					Debug(desync, 2, "newgrf property cache mismatch: type {}, vehicle {}, company {}, unit number {}, wagon {}, property {}", v->type, v->index, v->owner, v->unitnumber, length, prop_cache[length].property[i]);
+				}
+			}
 			if (memcmp(&veh_cache[length], &u->vcache, sizeof(VehicleCache)) != 0) {
 				Debug(desync, 2, "vehicle cache mismatch: type {}, vehicle {}, company {}, unit number {}, wagon {}", v->type, v->index, v->owner, v->unitnumber, length);
 			}
@@ -1288,6 +1295,7 @@ static void CheckCaches()
 		}
 
 		free(grf_cache);
+		free(prop_cache);
 		free(veh_cache);
 		free(gro_cache);
 		free(tra_cache);
@@ -1378,6 +1386,7 @@ void StateGameLoop()
 		PerformanceMeasurer::Paused(PFE_GL_SHIPS);
 		PerformanceMeasurer::Paused(PFE_GL_AIRCRAFT);
 		PerformanceMeasurer::Paused(PFE_GL_LANDSCAPE);
+		PerformanceMeasurer::Paused(PFE_GL_INDUSTRIES);
 
 		if (!HasModalProgress()) UpdateLandscapingLimits();
 #ifndef DEBUG_DUMP_COMMANDS
@@ -1388,6 +1397,7 @@ void StateGameLoop()
 
 	PerformanceMeasurer framerate(PFE_GAMELOOP);
 	PerformanceAccumulator::Reset(PFE_GL_LANDSCAPE);
+	PerformanceAccumulator::Reset(PFE_GL_INDUSTRIES);
 
 	Layouter::ReduceLineCache();
 
@@ -1498,8 +1508,6 @@ void GameLoop()
 		_switch_mode = SM_NONE;
 	}
 
-	IncreaseSpriteLRU();
-
 	/* Check for UDP stuff */
 	if (_network_available) NetworkBackgroundLoop();
 
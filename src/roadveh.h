@@ -117,6 +117,9 @@ struct RoadVehicle FINAL : public GroundVehicle<RoadVehicle, VEH_ROAD> {
 	RoadType roadtype;              //!< Roadtype of this vehicle.
 	RoadTypes compatible_roadtypes; //!< Roadtypes this consist is powered on.
 
+	RoadVehicle *hash_road_next;    ///< NOSAVE: Next road vehicle in the tile location hash of road vehicles.
+	RoadVehicle **hash_road_prev;   ///< NOSAVE: Previous road vehicle in the tile location hash of road vehicles.
+
 	/** We don't want GCC to zero our struct! It already is zeroed and has an index! */
 	RoadVehicle() : GroundVehicleBase() {}
 	/** We want to 'destruct' the right class. */
@@ -2205,6 +2205,7 @@ bool AfterLoadGame()
 				tile++;
 			}
 		}
+		RebuildAnimatedTileIndex();
 	}
 
 	if (IsSavegameVersionBefore(SLV_124) && !IsSavegameVersionBefore(SLV_1)) {
@@ -2685,6 +2686,14 @@ bool AfterLoadGame()
 			assert(v->tile != TileVirtXY(v->x_pos, v->y_pos) || v->z_pos == GetSlopePixelZ(v->x_pos, v->y_pos));
 		}
 
+		/* The inclination flags changed, so the cached slope resistance of the consists did too. */
+		for (Train *t : Train::Iterate()) {
+			if (t->First() == t) t->UpdateSlopeResistance();
+		}
+		for (RoadVehicle *rv : RoadVehicle::Iterate()) {
+			if (rv->IsFrontEngine()) rv->UpdateSlopeResistance();
+		}
+
 		/* Fill Vehicle::cur_real_order_index */
 		for (Vehicle *v : Vehicle::Iterate()) {
 			if (!v->IsPrimaryVehicle()) continue;
@@ -3207,6 +3216,12 @@ bool AfterLoadGame()
 	/* Compute station catchment areas. This is needed here in case UpdateStationAcceptance is called below. */
 	Station::RecomputeCatchmentForAll();
 
+	/* Schedule the growth of the growing towns, now their grow counters are converted. */
+	RebuildTownGrowthSchedule();
+
+	/* Schedule the industry ticks by the loaded industry counters. */
+	RebuildIndustryTickSchedule();
+
 	/* Station acceptance is some kind of cache */
 	if (IsSavegameVersionBefore(SLV_127)) {
 		for (Station *st : Station::Iterate()) UpdateStationAcceptance(st, false);
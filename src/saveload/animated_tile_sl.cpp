@@ -13,6 +13,7 @@
 #include "compat/animated_tile_sl_compat.h"
 
 #include "../tile_type.h"
+#include "../animated_tile_func.h"
 #include "../core/alloc_func.hpp"
 #include "../core/smallvec_type.hpp"
 
@@ -29,6 +30,8 @@ struct ANITChunkHandler : ChunkHandler {
 
 	void Save() const override
 	{
+		CompactAnimatedTiles();
+
 		SlTableHeader(_animated_tile_desc);
 
 		SlSetArrayIndex(0);
@@ -47,22 +50,21 @@ struct ANITChunkHandler : ChunkHandler {
 				if (anim_list[i] == 0) break;
 				_animated_tiles.push_back(anim_list[i]);
 			}
-			return;
-		}
-
-		if (IsSavegameVersionBefore(SLV_RIFF_TO_ARRAY)) {
+		} else if (IsSavegameVersionBefore(SLV_RIFF_TO_ARRAY)) {
 			size_t count = SlGetFieldLength() / sizeof(_animated_tiles.front());
 			_animated_tiles.clear();
 			_animated_tiles.resize(_animated_tiles.size() + count);
 			SlCopy(_animated_tiles.data(), count, SLE_UINT32);
-			return;
-		}
+		} else {
+			const std::vector<SaveLoad> slt = SlCompatTableHeader(_animated_tile_desc, _animated_tile_sl_compat);
 
-		const std::vector<SaveLoad> slt = SlCompatTableHeader(_animated_tile_desc, _animated_tile_sl_compat);
+			if (SlIterateArray() != -1) {
+				SlGlobList(slt);
+				if (SlIterateArray() != -1) SlErrorCorrupt("Too many ANIT entries");
+			}
+		}
 
-		if (SlIterateArray() == -1) return;
-		SlGlobList(slt);
-		if (SlIterateArray() != -1) SlErrorCorrupt("Too many ANIT entries");
+		RebuildAnimatedTileIndex();
 	}
 };
 
@@ -88,6 +88,8 @@ struct INDYChunkHandler : ChunkHandler {
 
 		/* Write the industries */
 		for (Industry *ind : Industry::Iterate()) {
+			/* The counter is not kept up to date while the game runs. */
+			ind->counter = ind->GetCounter();
 			SlSetArrayIndex(ind->index);
 			SlObject(ind, _industry_desc);
 		}
@@ -289,6 +289,8 @@ struct CITYChunkHandler : ChunkHandler {
 		SlTableHeader(_town_desc);
 
 		for (Town *t : Town::Iterate()) {
+			/* The grow counter of towns that are scheduled to grow is not kept up to date. */
+			t->grow_counter = t->GetGrowCounter();
 			SlSetArrayIndex(t->index);
 			SlObject(t, _town_desc);
 		}
@@ -248,6 +248,8 @@ void AfterLoadVehicles(bool part_of_load)
 
 		if (part_of_load) v->fill_percent_te_id = INVALID_TE_ID;
 		v->first = nullptr;
+		/* The cached callback results may refer to NewGRFs that have been reloaded. */
+		v->grf_property_cache.Clear();
 		if (v->IsGroundVehicle()) v->GetGroundVehicleCache()->first_engine = INVALID_ENGINE;
 	}
 
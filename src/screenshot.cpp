@@ -28,6 +28,11 @@
 #include "landscape.h"
 #include "video/video_driver.hpp"
 #include "smallmap_gui.h"
+#include "settings_type.h"
+#include "thread.h"
+
+#include <condition_variable>
+#include <deque>
 
 #include "table/strings.h"
 
@@ -70,6 +75,7 @@ typedef bool ScreenshotHandlerProc(const char *name, ScreenshotCallback *callb,
 struct ScreenshotFormat {
 	const char *extension;       ///< File extension.
 	ScreenshotHandlerProc *proc; ///< Function for writing the screenshot.
+	bool top_down;               ///< Whether \c proc requests the lines in order from the top of the image.
 };
 
 #define MKCOLOUR(x)         TO_LE32X(x)
@@ -569,10 +575,10 @@ static bool MakePCXImage(const char *name, ScreenshotCallback *callb, void *user
 /** Available screenshot formats. */
 static const ScreenshotFormat _screenshot_formats[] = {
 #if defined(WITH_PNG)
-	{"png", &MakePNGImage},
+	{"png", &MakePNGImage, true},
 #endif
-	{"bmp", &MakeBMPImage},
-	{"pcx", &MakePCXImage},
+	{"bmp", &MakeBMPImage, false},
+	{"pcx", &MakePCXImage, true},
 };
 
 /** Get filename extension of current screenshot file format. */
@@ -799,6 +805,118 @@ void SetupScreenshotViewport(ScreenshotType t, Viewport *vp, uint32 width, uint3
 	}
 }
 
+/**
+ * Pipeline between the main thread, which renders a large screenshot strip by strip,
+ * and a worker thread running the file format handler that encodes and writes the lines.
+ * Rendering has to stay on the main thread as the viewport drawing code uses global state,
+ * but the encoding (mostly compression) of the previous strips can happen at the same time.
+ */
+struct ScreenshotPipeline {
+	static constexpr uint STRIP_HEIGHT = 64; ///< Number of lines rendered in one go.
+	static constexpr uint MAX_STRIPS = 4;    ///< Maximum number of strips rendered ahead of the encoder.
+
+	/** A block of rendered lines waiting to be encoded. */
+	struct Strip {
+		std::unique_ptr<byte[]> buf; ///< Pixel data, with a pitch of the screenshot width.
+		uint y;                      ///< First line in the strip.
+		uint n;                      ///< Number of lines in the strip.
+	};
+
+	Viewport *vp;                  ///< Viewport being rendered.
+	uint bytes_per_pixel;          ///< Bytes per pixel of the rendered data.
+
+	std::mutex lock;               ///< Lock for everything below.
+	std::condition_variable cv;    ///< Signalled whenever a strip is produced or consumed, or the encoder finishes.
+	std::deque<Strip> ready;       ///< Rendered strips, in order of increasing y.
+	std::vector<std::unique_ptr<byte[]>> spare; ///< Buffers of consumed strips that can be reused.
+	bool encoder_done = false;     ///< The format handler has returned, no more lines will be requested.
+
+	ScreenshotPipeline(Viewport *vp, uint bytes_per_pixel) : vp(vp), bytes_per_pixel(bytes_per_pixel) {}
+
+	/**
+	 * Get a buffer to render a strip into.
+	 * @return Buffer large enough for #STRIP_HEIGHT lines.
+	 */
+	std::unique_ptr<byte[]> GetBuffer()
+	{
+		std::lock_guard<std::mutex> guard(this->lock);
+		if (this->spare.empty()) return std::make_unique<byte[]>((size_t)STRIP_HEIGHT * this->vp->width * this->bytes_per_pixel);
+
+		std::unique_ptr<byte[]> buf = std::move(this->spare.back());
+		this->spare.pop_back();
+		return buf;
+	}
+
+	/**
+	 * Render all strips of the screenshot and hand them to the encoder.
+	 * Stops early when the encoder has finished, e.g. because of a write error.
+	 */
+	void Render()
+	{
+		uint next_report = 10;
+		for (uint y = 0; y < (uint)this->vp->height; y += STRIP_HEIGHT) {
+			{
+				std::unique_lock<std::mutex> guard(this->lock);
+				this->cv.wait(guard, [this]() { return this->encoder_done || this->ready.size() < MAX_STRIPS; });
+				if (this->encoder_done) return;
+			}
+
+			Strip strip;
+			strip.buf = this->GetBuffer();
+			strip.y = y;
+			strip.n = std::min<uint>(STRIP_HEIGHT, this->vp->height - y);
+			LargeWorldCallback(this->vp, strip.buf.get(), strip.y, this->vp->width, strip.n);
+
+			{
+				std::lock_guard<std::mutex> guard(this->lock);
+				this->ready.push_back(std::move(strip));
+			}
+			this->cv.notify_all();
+
+			uint progress = (y + STRIP_HEIGHT) * 100ULL / this->vp->height;
+			if (progress >= next_report && progress < 100) {
+				Debug(misc, 1, "Screenshot: rendered {}% of {} lines", progress, this->vp->height);
+				next_report = progress - progress % 10 + 10;
+			}
+		}
+	}
+
+	/**
+	 * Screenshot callback for the encoder side; copies rendered lines, waiting for them when needed.
+	 * @see ScreenshotCallback
+	 */
+	static void Callback(void *userdata, void *buf, uint y, uint pitch, uint n)
+	{
+		ScreenshotPipeline *pipe = (ScreenshotPipeline *)userdata;
+		byte *dst = (byte *)buf;
+		size_t line_size = (size_t)pipe->vp->width * pipe->bytes_per_pixel;
+
+		std::unique_lock<std::mutex> guard(pipe->lock);
+		while (n > 0) {
+			pipe->cv.wait(guard, [&]() { return !pipe->ready.empty(); });
+
+			Strip &strip = pipe->ready.front();
+			assert(y >= strip.y && y < strip.y + strip.n);
+
+			uint lines = std::min(n, strip.y + strip.n - y);
+			const byte *src = strip.buf.get() + (y - strip.y) * line_size;
+			for (uint i = 0; i < lines; i++) {
+				memcpy(dst, src, line_size);
+				dst += (size_t)pitch * pipe->bytes_per_pixel;
+				src += line_size;
+			}
+			y += lines;
+			n -= lines;
+
+			if (y == strip.y + strip.n) {
+				pipe->spare.push_back(std::move(strip.buf));
+				pipe->ready.pop_front();
+				pipe->cv.notify_all();
+			}
+		}
+	}
+};
+
 /**
  * Make a screenshot of the map.
  * @param t Screenshot type: World or viewport screenshot
@@ -812,8 +930,28 @@ static bool MakeLargeWorldScreenshot(ScreenshotType t, uint32 width = 0, uint32
 	SetupScreenshotViewport(t, &vp, width, height);
 
 	const ScreenshotFormat *sf = _screenshot_formats + _cur_screenshot_format;
-	return sf->proc(MakeScreenshotName(SCREENSHOT_NAME, sf->extension), LargeWorldCallback, &vp, vp.width, vp.height,
-			BlitterFactory::GetCurrentBlitter()->GetScreenDepth(), _cur_palette.palette);
+	const char *name = MakeScreenshotName(SCREENSHOT_NAME, sf->extension);
+	int depth = BlitterFactory::GetCurrentBlitter()->GetScreenDepth();
+
+	if (_settings_client.gui.threaded_screenshots && sf->top_down && (depth == 8 || depth == 32)) {
+		ScreenshotPipeline pipe(&vp, depth / 8);
+		bool ret = false;
+
+		std::thread encoder;
+		if (StartNewThread(&encoder, "ottd:screenshot", [&]() {
+				ret = sf->proc(name, &ScreenshotPipeline::Callback, &pipe, vp.width, vp.height, depth, _cur_palette.palette);
+
+				std::lock_guard<std::mutex> guard(pipe.lock);
+				pipe.encoder_done = true;
+				pipe.cv.notify_all();
+			})) {
+			pipe.Render();
+			encoder.join();
+			return ret;
+		}
+	}
+
+	return sf->proc(name, LargeWorldCallback, &vp, vp.width, vp.height, depth, _cur_palette.palette);
 }
 
 /**
@@ -1004,32 +1142,72 @@ bool MakeScreenshot(ScreenshotType t, std::string name, uint32 width, uint32 hei
 }
 
 
-static void MinimapScreenCallback(void *userdata, void *buf, uint y, uint pitch, uint n)
+/**
+ * Callback for generating a minimap screenshot. Supports 8bpp only.
+ * @param userdata Pointer to the #MinimapType to draw.
+ * @param buffer   Destination buffer.
+ * @param y        Line number of the first line to write.
+ * @param pitch    Number of pixels to write, one palette index byte per pixel.
+ * @param n        Number of lines to write.
+ * @see ScreenshotCallback
+ */
+static void MinimapScreenCallback(void *userdata, void *buffer, uint y, uint pitch, uint n)
 {
-	uint32 *ubuf = (uint32 *)buf;
-	uint num = (pitch * n);
-	for (uint i = 0; i < num; i++) {
-		uint row = y + (int)(i / pitch);
-		uint col = (MapSizeX() - 1) - (i % pitch);
-
-		TileIndex tile = TileXY(col, row);
-		byte val = GetSmallMapOwnerPixels(tile, GetTileType(tile), IncludeHeightmap::Never) & 0xFF;
-
-		uint32 colour_buf = 0;
-		colour_buf  = (_cur_palette.palette[val].b << 0);
-		colour_buf |= (_cur_palette.palette[val].g << 8);
-		colour_buf |= (_cur_palette.palette[val].r << 16);
-
-		*ubuf = colour_buf;
-		ubuf++;   // Skip alpha
+	MinimapType type = *(MinimapType *)userdata;
+	byte *buf = (byte *)buffer;
+	for (; n > 0; n--, y++, buf += pitch) {
+		GetMinimapRowColours(type, y, buf);
+	}
+}
+
+/**
+ * Write the palette indices of a minimap as raw bytes, one byte per tile and row after row.
+ * @param name Filename to use for saving.
+ * @param type Information to show.
+ * @return true iff the file was written successfully.
+ */
+static bool MakeRawMinimap(const char *name, MinimapType type)
+{
+	FILE *f = fopen(name, "wb");
+	if (f == nullptr) return false;
+
+	std::unique_ptr<uint8[]> row(new uint8[MapSizeX()]);
+	bool success = true;
+	for (uint y = 0; success && y < MapSizeY(); y++) {
+		GetMinimapRowColours(type, y, row.get());
+		success = fwrite(row.get(), MapSizeX(), 1, f) == 1;
 	}
+
+	fclose(f);
+	return success;
 }
 
 /**
  * Make a minimap screenshot.
+ * @param type What the minimap shows.
+ * @param raw  Write plain palette indices instead of using the screenshot format.
+ * @return true iff the file was written successfully.
  */
-bool MakeMinimapWorldScreenshot()
+bool MakeMinimapWorldScreenshot(MinimapType type, bool raw)
 {
+	if (raw) return MakeRawMinimap(MakeScreenshotName(SCREENSHOT_NAME, "raw"), type);
+
 	const ScreenshotFormat *sf = _screenshot_formats + _cur_screenshot_format;
-	return sf->proc(MakeScreenshotName(SCREENSHOT_NAME, sf->extension), MinimapScreenCallback, nullptr, MapSizeX(), MapSizeY(), 32, _cur_palette.palette);
+	return sf->proc(MakeScreenshotName(SCREENSHOT_NAME, sf->extension), MinimapScreenCallback, &type, MapSizeX(), MapSizeY(), 8, _cur_palette.palette);
+}
+
+/**
+ * Immediately make a minimap of the world, without going through the video driver.
+ * This makes it usable from the console of a dedicated server.
+ * @param type What the minimap shows.
+ * @param raw  Write plain palette indices instead of using the screenshot format.
+ * @param name The name to give to the file, or empty for a generated one.
+ * @return true iff the file was written successfully.
+ */
+bool MakeMinimapExport(MinimapType type, bool raw, const std::string &name)
+{
+	_screenshot_name[0] = '\0';
+	if (!name.empty()) strecpy(_screenshot_name, name.c_str(), lastof(_screenshot_name));
+
+	return MakeMinimapWorldScreenshot(type, raw);
 }
@@ -25,11 +25,20 @@ enum ScreenshotType {
 	SC_MINIMAP,     ///< Minimap screenshot.
 };
 
+/** Information shown in a minimap screenshot. */
+enum MinimapType {
+	MMT_OWNER,      ///< Owner of every tile.
+	MMT_INDUSTRY,   ///< Industries in the colour of their type.
+	MMT_ROUTES,     ///< Rail, road and station types.
+	MMT_VEGETATION, ///< Ground and tree cover.
+};
+
 void SetupScreenshotViewport(ScreenshotType t, struct Viewport *vp, uint32 width = 0, uint32 height = 0);
 bool MakeHeightmapScreenshot(const char *filename);
 void MakeScreenshotWithConfirm(ScreenshotType t);
 bool MakeScreenshot(ScreenshotType t, std::string name, uint32 width = 0, uint32 height = 0);
-bool MakeMinimapWorldScreenshot();
+bool MakeMinimapWorldScreenshot(MinimapType type = MMT_OWNER, bool raw = false);
+bool MakeMinimapExport(MinimapType type, bool raw, const std::string &name);
 
 extern std::string _screenshot_format_name;
 extern uint _num_screenshot_formats;
@@ -17,11 +17,22 @@
  *
  * API additions:
  * \li AICargo::GetWeight
+ * \li AIController::SaveDataChanged
+ * \li AIController::SetSaveDataCaching
+ * \li AIEventController::GetCoalescedEventCount
+ * \li AIEventController::GetDroppedEventCount
+ * \li AIEventController::IsEventTypeEnabled
+ * \li AIEventController::SetEventTypeEnabled
  * \li AIIndustryType::ResolveNewGRFID
+ * \li AIList::ValuateNative
  * \li AIObjectType::ResolveNewGRFID
+ * \li AIPathfinder
+ * \li AITileList_Attributes
  *
  * Other changes:
  * \li AIRoad::HasRoadType now correctly checks RoadType against RoadType
+ * \li The event queue can be limited with the script_max_events setting; when it is full the oldest event the script does not have to reply to is thrown away
+ * \li Some events are not queued when an identical event is still waiting in the queue
  *
  * \b 12.0
  *
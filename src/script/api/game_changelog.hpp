@@ -17,12 +17,23 @@
  *
  * API additions:
  * \li GSCargo::GetWeight
+ * \li GSController::SaveDataChanged
+ * \li GSController::SetSaveDataCaching
+ * \li GSEventController::GetCoalescedEventCount
+ * \li GSEventController::GetDroppedEventCount
+ * \li GSEventController::IsEventTypeEnabled
+ * \li GSEventController::SetEventTypeEnabled
  * \li GSIndustryType::ResolveNewGRFID
+ * \li GSList::ValuateNative
  * \li GSObjectType::ResolveNewGRFID
+ * \li GSPathfinder
+ * \li GSTileList_Attributes
  * \li GSLeagueTable
  *
  * Other changes:
  * \li GSRoad::HasRoadType now correctly checks RoadType against RoadType
+ * \li The event queue can be limited with the script_max_events setting; when it is full the oldest event the script does not have to reply to is thrown away
+ * \li Some events are not queued when an identical event is still waiting in the queue
  *
  * \b 12.0
  *
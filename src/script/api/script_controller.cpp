@@ -45,6 +45,16 @@
 	throw Script_Suspend(ticks, nullptr);
 }
 
+/* static */ void ScriptController::SetSaveDataCaching(bool enable)
+{
+	ScriptObject::GetActiveInstance()->SetSaveDataCaching(enable);
+}
+
+/* static */ void ScriptController::SaveDataChanged()
+{
+	ScriptObject::GetActiveInstance()->InvalidateSaveData();
+}
+
 /* static */ void ScriptController::Break(const char* message)
 {
 	if (_network_dedicated || !_settings_client.gui.ai_developer_tools) return;
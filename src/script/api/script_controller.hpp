@@ -188,6 +188,25 @@ public:
 	 */
 	static void Break(const char* message);
 
+	/**
+	 * Keep the data returned by your Save() function between saves, until you
+	 *  call SaveDataChanged(). Normally Save() is called for every save once
+	 *  your script has run since the previous one. With many scripts, or a lot
+	 *  of save data, this makes saving and sending the map to joining clients
+	 *  a lot faster.
+	 * @param enable True to keep the save data until SaveDataChanged() is called.
+	 * @note Only use this when your Save() function returns data that depends on
+	 *  nothing but your own state, so you know when it changes.
+	 */
+	static void SetSaveDataCaching(bool enable);
+
+	/**
+	 * Tell that the data your Save() function returns has changed, so it is
+	 *  called again for the next save. This is only needed when
+	 *  SetSaveDataCaching() is enabled.
+	 */
+	static void SaveDataChanged();
+
 	/**
 	 * When Squirrel triggers a print, this function is called.
 	 *  Squirrel calls this when 'print' is used, or when the script made an error.
@@ -8,17 +8,38 @@
 /** @file script_event.cpp Implementation of ScriptEvent. */
 
 #include "../../stdafx.h"
+#include "../../debug.h"
+#include "../../settings_type.h"
 #include "script_event_types.hpp"
 
-#include <queue>
+#include <algorithm>
+#include <deque>
+#include <unordered_set>
 
 #include "../../safeguards.h"
 
 /** The queue of events for a script. */
 struct ScriptEventData {
-	std::queue<ScriptEvent *> stack; ///< The actual queue.
+	std::deque<std::pair<ScriptEvent *, uint64>> queue; ///< The actual queue, with the coalesce key of every event.
+	std::unordered_set<uint64> waiting;                  ///< Coalesce keys of the events waiting in the queue.
+	uint64 disabled_types = 0;                           ///< Bit mask of the event types that are not queued.
+	uint dropped = 0;                                    ///< Number of events thrown away because the queue was full.
+	uint coalesced = 0;                                  ///< Number of events not queued because an identical event was waiting.
 };
 
+/**
+ * Remove the oldest event from the queue.
+ * @param data The event data.
+ * @return The removed event; the caller takes over its reference.
+ */
+static ScriptEvent *PopEvent(ScriptEventData *data)
+{
+	auto [e, key] = data->queue.front();
+	data->queue.pop_front();
+	if (key != 0) data->waiting.erase(key);
+	return e;
+}
+
 /* static */ void ScriptEventController::CreateEventPointer()
 {
 	assert(ScriptObject::GetEventPointer() == nullptr);
@@ -31,10 +52,8 @@ struct ScriptEventData {
 	ScriptEventData *data = (ScriptEventData *)ScriptObject::GetEventPointer();
 
 	/* Free all waiting events (if any) */
-	while (!data->stack.empty()) {
-		ScriptEvent *e = data->stack.front();
-		data->stack.pop();
-		e->Release();
+	while (!data->queue.empty()) {
+		PopEvent(data)->Release();
 	}
 
 	/* Now kill our data pointer */
@@ -46,7 +65,7 @@ struct ScriptEventData {
 	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
 	ScriptEventData *data = (ScriptEventData *)ScriptObject::GetEventPointer();
 
-	return !data->stack.empty();
+	return !data->queue.empty();
 }
 
 /* static */ ScriptEvent *ScriptEventController::GetNextEvent()
@@ -54,11 +73,45 @@ struct ScriptEventData {
 	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
 	ScriptEventData *data = (ScriptEventData *)ScriptObject::GetEventPointer();
 
-	if (data->stack.empty()) return nullptr;
+	if (data->queue.empty()) return nullptr;
 
-	ScriptEvent *e = data->stack.front();
-	data->stack.pop();
-	return e;
+	return PopEvent(data);
+}
+
+/* static */ void ScriptEventController::SetEventTypeEnabled(ScriptEvent::ScriptEventType event_type, bool enabled)
+{
+	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
+	ScriptEventData *data = (ScriptEventData *)ScriptObject::GetEventPointer();
+
+	if ((uint)event_type >= 64) return;
+	if (enabled) {
+		ClrBit(data->disabled_types, event_type);
+	} else {
+		SetBit(data->disabled_types, event_type);
+	}
+}
+
+/* static */ bool ScriptEventController::IsEventTypeEnabled(ScriptEvent::ScriptEventType event_type)
+{
+	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
+	ScriptEventData *data = (ScriptEventData *)ScriptObject::GetEventPointer();
+
+	if ((uint)event_type >= 64) return false;
+	return !HasBit(data->disabled_types, event_type);
+}
+
+/* static */ SQInteger ScriptEventController::GetDroppedEventCount()
+{
+	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
+
+	return ((ScriptEventData *)ScriptObject::GetEventPointer())->dropped;
+}
+
+/* static */ SQInteger ScriptEventController::GetCoalescedEventCount()
+{
+	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
+
+	return ((ScriptEventData *)ScriptObject::GetEventPointer())->coalesced;
 }
 
 /* static */ void ScriptEventController::InsertEvent(ScriptEvent *event)
@@ -66,7 +119,33 @@ struct ScriptEventData {
 	if (ScriptObject::GetEventPointer() == nullptr) ScriptEventController::CreateEventPointer();
 	ScriptEventData *data = (ScriptEventData *)ScriptObject::GetEventPointer();
 
+	if ((uint)event->type < 64 && HasBit(data->disabled_types, event->type)) return;
+
+	uint64 key = event->GetCoalesceKey();
+	if (key != 0 && !data->waiting.insert(key).second) {
+		data->coalesced++;
+		return;
+	}
+
+	/* When the script does not keep up, throw away the oldest events instead of growing without bounds. */
+	uint max_events = _settings_game.script.script_max_events;
+	if (max_events != 0 && data->queue.size() >= max_events) {
+		/* Events the script has to reply to are kept, even when that leaves the queue over its limit. */
+		auto iter = data->queue.begin();
+		while (data->queue.size() >= max_events) {
+			iter = std::find_if(iter, data->queue.end(), [](const auto &entry) { return !entry.first->NeedsReply(); });
+			if (iter == data->queue.end()) break;
+
+			auto [e, key] = *iter;
+			iter = data->queue.erase(iter);
+			if (key != 0) data->waiting.erase(key);
+
+			data->dropped++;
+			Debug(script, 1, "Event queue of the script is full, threw away an event of type {} ({} events thrown away so far)", (int)e->GetEventType(), data->dropped);
+			e->Release();
+		}
+	}
+
 	event->AddRef();
-	data->stack.push(event);
+	data->queue.emplace_back(event, key);
 }
-
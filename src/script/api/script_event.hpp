@@ -74,10 +74,37 @@ public:
 	ScriptEventType GetEventType() { return this->type; }
 
 protected:
+	friend class ScriptEventController;
+
 	/**
 	 * The type of this event.
 	 */
 	ScriptEventType type;
+
+	/**
+	 * Get the key to recognise an identical event with, so an event that is
+	 *  still waiting in the queue is not queued a second time.
+	 * @return The key, or 0 when this event is always queued.
+	 */
+	virtual uint64 GetCoalesceKey() const { return 0; }
+
+	/**
+	 * Check whether the script has to answer this event, so it is never
+	 *  thrown away when the queue is full.
+	 * @return True iff the event asks the script for a reply.
+	 */
+	bool NeedsReply() const
+	{
+		switch (this->type) {
+			case ET_ENGINE_PREVIEW:
+			case ET_COMPANY_ASK_MERGER:
+			case ET_GOAL_QUESTION_ANSWER:
+				return true;
+
+			default:
+				return false;
+		}
+	}
 };
 
 /**
@@ -100,6 +127,39 @@ public:
 	 */
 	static ScriptEvent *GetNextEvent();
 
+	/**
+	 * Set whether events of a type are put in the queue. Events of a disabled
+	 *  type are thrown away when they happen, so they cost the script nothing.
+	 *  By default all types are enabled.
+	 * @param event_type The type of event.
+	 * @param enabled True iff events of this type should be queued.
+	 * @note Events of the type that are already waiting stay in the queue.
+	 * @note This is not saved; set it again when the script is loaded.
+	 */
+	static void SetEventTypeEnabled(ScriptEvent::ScriptEventType event_type, bool enabled);
+
+	/**
+	 * Check whether events of a type are put in the queue.
+	 * @param event_type The type of event.
+	 * @return True iff events of this type are queued.
+	 */
+	static bool IsEventTypeEnabled(ScriptEvent::ScriptEventType event_type);
+
+	/**
+	 * Get the number of events that were thrown away because the queue was
+	 *  full. When the queue is full the oldest event is thrown away, unless
+	 *  the script has to reply to it.
+	 * @return The number of events thrown away.
+	 */
+	static SQInteger GetDroppedEventCount();
+
+	/**
+	 * Get the number of events that were not queued because an identical
+	 *  event was still waiting in the queue.
+	 * @return The number of events not queued.
+	 */
+	static SQInteger GetCoalescedEventCount();
+
 	/**
 	 * Insert an event to the queue for the company.
 	 * @param event The event to insert.
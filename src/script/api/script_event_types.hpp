@@ -368,6 +368,8 @@ public:
 
 private:
 	ScriptCompany::CompanyID owner; ///< The company that is in trouble.
+
+	uint64 GetCoalesceKey() const override { return (uint64)this->type << 56 | (uint32)this->owner; }
 };
 
 /**
@@ -496,6 +498,8 @@ public:
 
 private:
 	ScriptCompany::CompanyID owner; ///< The company that has gone bankrupt.
+
+	uint64 GetCoalesceKey() const override { return (uint64)this->type << 56 | (uint32)this->owner; }
 };
 
 /**
@@ -529,6 +533,8 @@ public:
 
 private:
 	VehicleID vehicle_id; ///< The vehicle that is lost.
+
+	uint64 GetCoalesceKey() const override { return (uint64)this->type << 56 | this->vehicle_id; }
 };
 
 /**
@@ -562,6 +568,8 @@ public:
 
 private:
 	VehicleID vehicle_id; ///< The vehicle that is waiting in the depot.
+
+	uint64 GetCoalesceKey() const override { return (uint64)this->type << 56 | this->vehicle_id; }
 };
 
 /**
@@ -595,6 +603,8 @@ public:
 
 private:
 	VehicleID vehicle_id; ///< The vehicle that is unprofitable.
+
+	uint64 GetCoalesceKey() const override { return (uint64)this->type << 56 | this->vehicle_id; }
 };
 
 /**
@@ -736,6 +746,8 @@ public:
 private:
 	StationID station; ///< The station the vehicle arrived at.
 	VehicleID vehicle; ///< The vehicle that arrived at the station.
+
+	uint64 GetCoalesceKey() const override { return (uint64)this->type << 56 | (uint64)this->station << 32 | this->vehicle; }
 };
 
 /**
@@ -870,6 +882,8 @@ public:
 
 private:
 	VehicleID vehicle_id; ///< The vehicle aircraft whose destination is too far away.
+
+	uint64 GetCoalesceKey() const override { return (uint64)this->type << 56 | this->vehicle_id; }
 };
 
 /**
@@ -10,131 +10,97 @@
 #include "../../stdafx.h"
 #include "script_list.hpp"
 #include "script_controller.hpp"
+#include "script_industry.hpp"
+#include "script_tile.hpp"
+#include "../script_instance.hpp"
 #include "../../debug.h"
 #include "../../script/squirrel.hpp"
+#include <algorithm>
 
 #include "../../safeguards.h"
 
 /**
  * Base class for any ScriptList sorter.
+ * Sorters remember the next item by its key instead of by an iterator, so
+ * they stay valid while the list is changed during the iteration.
  */
 class ScriptListSorter {
 protected:
 	ScriptList *list;       ///< The list that's being sorted.
 	bool has_no_more_items; ///< Whether we have more items to iterate over.
+	bool at_last_item;      ///< Whether #item_next is the last item of the list.
 	int64 item_next;        ///< The next item we will show.
+	int64 value_next;       ///< The value of the next item we will show, when sorting by value.
 
-public:
 	/**
-	 * Virtual dtor, needed to mute warnings.
+	 * Get the items ordered by value.
+	 * @return Value/item pairs of all items.
 	 */
-	virtual ~ScriptListSorter() { }
-
-	/**
-	 * Get the first item of the sorter.
-	 */
-	virtual int64 Begin() = 0;
+	const ScriptList::ScriptListValueMap &GetValues()
+	{
+		return this->list->GetValues();
+	}
 
 	/**
-	 * Stop iterating a sorter.
+	 * Find the first item in the sort order.
+	 * @pre The list is not empty.
 	 */
-	virtual void End() = 0;
+	virtual void FindFirst() = 0;
 
 	/**
-	 * Get the next item of the sorter.
+	 * Find the item following #item_next in the sort order.
+	 * @return False iff there is no such item.
 	 */
-	virtual int64 Next() = 0;
+	virtual bool FindSuccessor() = 0;
 
 	/**
-	 * See if the sorter has reached the end.
+	 * Find the next item, and store that information.
 	 */
-	bool IsEnd()
+	void FindNext()
 	{
-		return this->list->buckets.empty() || this->has_no_more_items;
+		if (this->at_last_item) {
+			this->has_no_more_items = true;
+			return;
+		}
+		this->at_last_item = !this->FindSuccessor();
 	}
 
+public:
 	/**
-	 * Callback from the list if an item gets removed.
-	 */
-	virtual void Remove(int item) = 0;
-
-	/**
-	 * Attach the sorter to a new list. This assumes the content of the old list has been moved to
-	 * the new list, too, so that we don't have to invalidate any iterators. Note that std::swap
-	 * doesn't invalidate iterators on lists and maps, so that should be safe.
-	 * @param target New list to attach to.
+	 * Virtual dtor, needed to mute warnings.
 	 */
-	virtual void Retarget(ScriptList *new_list)
-	{
-		this->list = new_list;
-	}
-};
-
-/**
- * Sort by value, ascending.
- */
-class ScriptListSorterValueAscending : public ScriptListSorter {
-private:
-	ScriptList::ScriptListBucket::iterator bucket_iter;    ///< The iterator over the list to find the buckets.
-	ScriptList::ScriptItemList *bucket_list;               ///< The current bucket list we're iterator over.
-	ScriptList::ScriptItemList::iterator bucket_list_iter; ///< The iterator over the bucket list.
+	virtual ~ScriptListSorter() { }
 
-public:
 	/**
-	 * Create a new sorter.
-	 * @param list The list to sort.
+	 * Get the first item of the sorter.
 	 */
-	ScriptListSorterValueAscending(ScriptList *list)
-	{
-		this->list = list;
-		this->End();
-	}
-
 	int64 Begin()
 	{
-		if (this->list->buckets.empty()) return 0;
+		if (this->list->items.empty()) return 0;
 		this->has_no_more_items = false;
+		this->at_last_item = false;
 
-		this->bucket_iter = this->list->buckets.begin();
-		this->bucket_list = &(*this->bucket_iter).second;
-		this->bucket_list_iter = this->bucket_list->begin();
-		this->item_next = *this->bucket_list_iter;
+		this->FindFirst();
 
 		int64 item_current = this->item_next;
 		FindNext();
 		return item_current;
 	}
 
+	/**
+	 * Stop iterating a sorter.
+	 */
 	void End()
 	{
-		this->bucket_list = nullptr;
 		this->has_no_more_items = true;
+		this->at_last_item = true;
 		this->item_next = 0;
+		this->value_next = 0;
 	}
 
 	/**
-	 * Find the next item, and store that information.
+	 * Get the next item of the sorter.
 	 */
-	void FindNext()
-	{
-		if (this->bucket_list == nullptr) {
-			this->has_no_more_items = true;
-			return;
-		}
-
-		this->bucket_list_iter++;
-		if (this->bucket_list_iter == this->bucket_list->end()) {
-			this->bucket_iter++;
-			if (this->bucket_iter == this->list->buckets.end()) {
-				this->bucket_list = nullptr;
-				return;
-			}
-			this->bucket_list = &(*this->bucket_iter).second;
-			this->bucket_list_iter = this->bucket_list->begin();
-		}
-		this->item_next = *this->bucket_list_iter;
-	}
-
 	int64 Next()
 	{
 		if (this->IsEnd()) return 0;
@@ -144,7 +110,19 @@ public:
 		return item_current;
 	}
 
-	void Remove(int item)
+	/**
+	 * See if the sorter has reached the end.
+	 */
+	bool IsEnd()
+	{
+		return this->list->items.empty() || this->has_no_more_items;
+	}
+
+	/**
+	 * Callback from the list if an item gets removed, or its value changed.
+	 * @param item The item that is removed.
+	 */
+	void Remove(int64 item)
 	{
 		if (this->IsEnd()) return;
 
@@ -154,102 +132,98 @@ public:
 			return;
 		}
 	}
+
+	/**
+	 * Callback from the list after any number of items have been removed at once.
+	 */
+	void RemovedItems()
+	{
+		if (this->has_no_more_items || this->list->HasItem(this->item_next)) return;
+
+		/* The successor is found by key, so this works even though the 'next' item is gone.
+		 * When all following items are gone as well, there is nothing left to show. */
+		if (this->at_last_item || !this->FindSuccessor()) this->End();
+	}
+
+	/**
+	 * Attach the sorter to a new list. This assumes the content of the old list has been moved to
+	 * the new list, too. As the position is kept by key, no further work is needed.
+	 * @param target New list to attach to.
+	 */
+	void Retarget(ScriptList *new_list)
+	{
+		this->list = new_list;
+	}
 };
 
 /**
- * Sort by value, descending.
+ * Sort by value, ascending.
  */
-class ScriptListSorterValueDescending : public ScriptListSorter {
-private:
-	/* Note: We cannot use reverse_iterator.
-	 *       The iterators must only be invalidated when the element they are pointing to is removed.
-	 *       This only holds for forward iterators. */
-	ScriptList::ScriptListBucket::iterator bucket_iter;    ///< The iterator over the list to find the buckets.
-	ScriptList::ScriptItemList *bucket_list;               ///< The current bucket list we're iterator over.
-	ScriptList::ScriptItemList::iterator bucket_list_iter; ///< The iterator over the bucket list.
-
+class ScriptListSorterValueAscending : public ScriptListSorter {
 public:
 	/**
 	 * Create a new sorter.
 	 * @param list The list to sort.
 	 */
-	ScriptListSorterValueDescending(ScriptList *list)
+	ScriptListSorterValueAscending(ScriptList *list)
 	{
 		this->list = list;
 		this->End();
 	}
 
-	int64 Begin()
+protected:
+	void FindFirst() override
 	{
-		if (this->list->buckets.empty()) return 0;
-		this->has_no_more_items = false;
-
-		/* Go to the end of the bucket-list */
-		this->bucket_iter = this->list->buckets.end();
-		--this->bucket_iter;
-		this->bucket_list = &(*this->bucket_iter).second;
-
-		/* Go to the end of the items in the bucket */
-		this->bucket_list_iter = this->bucket_list->end();
-		--this->bucket_list_iter;
-		this->item_next = *this->bucket_list_iter;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
+		const ScriptList::ScriptListValueMap &values = this->GetValues();
+		this->value_next = values.begin()->first;
+		this->item_next = values.begin()->second;
 	}
 
-	void End()
+	bool FindSuccessor() override
 	{
-		this->bucket_list = nullptr;
-		this->has_no_more_items = true;
-		this->item_next = 0;
+		const ScriptList::ScriptListValueMap &values = this->GetValues();
+		auto iter = values.upper_bound(ScriptList::ScriptListPair(this->value_next, this->item_next));
+		if (iter == values.end()) return false;
+
+		this->value_next = iter->first;
+		this->item_next = iter->second;
+		return true;
 	}
+};
 
+/**
+ * Sort by value, descending.
+ */
+class ScriptListSorterValueDescending : public ScriptListSorter {
+public:
 	/**
-	 * Find the next item, and store that information.
+	 * Create a new sorter.
+	 * @param list The list to sort.
 	 */
-	void FindNext()
+	ScriptListSorterValueDescending(ScriptList *list)
 	{
-		if (this->bucket_list == nullptr) {
-			this->has_no_more_items = true;
-			return;
-		}
-
-		if (this->bucket_list_iter == this->bucket_list->begin()) {
-			if (this->bucket_iter == this->list->buckets.begin()) {
-				this->bucket_list = nullptr;
-				return;
-			}
-			this->bucket_iter--;
-			this->bucket_list = &(*this->bucket_iter).second;
-			/* Go to the end of the items in the bucket */
-			this->bucket_list_iter = this->bucket_list->end();
-			--this->bucket_list_iter;
-		} else {
-			this->bucket_list_iter--;
-		}
-		this->item_next = *this->bucket_list_iter;
+		this->list = list;
+		this->End();
 	}
 
-	int64 Next()
+protected:
+	void FindFirst() override
 	{
-		if (this->IsEnd()) return 0;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
+		const ScriptList::ScriptListValueMap &values = this->GetValues();
+		this->value_next = values.rbegin()->first;
+		this->item_next = values.rbegin()->second;
 	}
 
-	void Remove(int item)
+	bool FindSuccessor() override
 	{
-		if (this->IsEnd()) return;
+		const ScriptList::ScriptListValueMap &values = this->GetValues();
+		auto iter = values.lower_bound(ScriptList::ScriptListPair(this->value_next, this->item_next));
+		if (iter == values.begin()) return false;
 
-		/* If we remove the 'next' item, skip to the next */
-		if (item == this->item_next) {
-			FindNext();
-			return;
-		}
+		--iter;
+		this->value_next = iter->first;
+		this->item_next = iter->second;
+		return true;
 	}
 };
 
@@ -257,9 +231,6 @@ public:
  * Sort by item, ascending.
  */
 class ScriptListSorterItemAscending : public ScriptListSorter {
-private:
-	ScriptList::ScriptListMap::iterator item_iter; ///< The iterator over the items in the map.
-
 public:
 	/**
 	 * Create a new sorter.
@@ -271,55 +242,20 @@ public:
 		this->End();
 	}
 
-	int64 Begin()
-	{
-		if (this->list->items.empty()) return 0;
-		this->has_no_more_items = false;
-
-		this->item_iter = this->list->items.begin();
-		this->item_next = (*this->item_iter).first;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void End()
-	{
-		this->has_no_more_items = true;
-	}
-
-	/**
-	 * Find the next item, and store that information.
-	 */
-	void FindNext()
-	{
-		if (this->item_iter == this->list->items.end()) {
-			this->has_no_more_items = true;
-			return;
-		}
-		this->item_iter++;
-		if (this->item_iter != this->list->items.end()) item_next = (*this->item_iter).first;
-	}
-
-	int64 Next()
+protected:
+	void FindFirst() override
 	{
-		if (this->IsEnd()) return 0;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
+		this->item_next = this->list->items.begin()->first;
 	}
 
-	void Remove(int item)
+	bool FindSuccessor() override
 	{
-		if (this->IsEnd()) return;
+		const ScriptList::ScriptListMap &items = this->list->items;
+		auto iter = items.upper_bound(this->item_next);
+		if (iter == items.end()) return false;
 
-		/* If we remove the 'next' item, skip to the next */
-		if (item == this->item_next) {
-			FindNext();
-			return;
-		}
+		this->item_next = iter->first;
+		return true;
 	}
 };
 
@@ -327,12 +263,6 @@ public:
  * Sort by item, descending.
  */
 class ScriptListSorterItemDescending : public ScriptListSorter {
-private:
-	/* Note: We cannot use reverse_iterator.
-	 *       The iterators must only be invalidated when the element they are pointing to is removed.
-	 *       This only holds for forward iterators. */
-	ScriptList::ScriptListMap::iterator item_iter; ///< The iterator over the items in the map.
-
 public:
 	/**
 	 * Create a new sorter.
@@ -344,61 +274,21 @@ public:
 		this->End();
 	}
 
-	int64 Begin()
-	{
-		if (this->list->items.empty()) return 0;
-		this->has_no_more_items = false;
-
-		this->item_iter = this->list->items.end();
-		--this->item_iter;
-		this->item_next = (*this->item_iter).first;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void End()
-	{
-		this->has_no_more_items = true;
-	}
-
-	/**
-	 * Find the next item, and store that information.
-	 */
-	void FindNext()
-	{
-		if (this->item_iter == this->list->items.end()) {
-			this->has_no_more_items = true;
-			return;
-		}
-		if (this->item_iter == this->list->items.begin()) {
-			/* Use 'end' as marker for 'beyond begin' */
-			this->item_iter = this->list->items.end();
-		} else {
-			this->item_iter--;
-		}
-		if (this->item_iter != this->list->items.end()) item_next = (*this->item_iter).first;
-	}
-
-	int64 Next()
+protected:
+	void FindFirst() override
 	{
-		if (this->IsEnd()) return 0;
-
-		int64 item_current = this->item_next;
-		FindNext();
-		return item_current;
+		this->item_next = this->list->items.rbegin()->first;
 	}
 
-	void Remove(int item)
+	bool FindSuccessor() override
 	{
-		if (this->IsEnd()) return;
+		const ScriptList::ScriptListMap &items = this->list->items;
+		auto iter = items.lower_bound(this->item_next);
+		if (iter == items.begin()) return false;
 
-		/* If we remove the 'next' item, skip to the next */
-		if (item == this->item_next) {
-			FindNext();
-			return;
-		}
+		--iter;
+		this->item_next = iter->first;
+		return true;
 	}
 };
 
@@ -412,6 +302,7 @@ ScriptList::ScriptList()
 	this->sort_ascending = false;
 	this->initialized    = false;
 	this->modifications  = 0;
+	this->values_valid   = true;
 }
 
 ScriptList::~ScriptList()
@@ -419,9 +310,101 @@ ScriptList::~ScriptList()
 	delete this->sorter;
 }
 
+/**
+ * Get the items ordered by value. The ordering is built when first needed
+ *  after a bulk change, and kept up to date for single changes after that.
+ * @return Value/item pairs of all items.
+ */
+const ScriptList::ScriptListValueMap &ScriptList::GetValues()
+{
+	if (!this->values_valid) {
+		this->values.clear();
+		for (const auto &pair : this->items) {
+			this->values.emplace(pair.second, pair.first);
+		}
+		this->values_valid = true;
+	}
+	return this->values;
+}
+
+/**
+ * Remove all items matching a predicate in one pass.
+ * @param predicate Function called with the item and its value, returning true when the item has to be removed.
+ */
+template <typename Tpredicate>
+void ScriptList::RemoveItems(Tpredicate predicate)
+{
+	this->modifications++;
+
+	bool removed = false;
+	for (auto iter = this->items.begin(); iter != this->items.end();) {
+		if (!predicate(iter->first, iter->second)) {
+			++iter;
+			continue;
+		}
+
+		if (this->values_valid) this->values.erase(ScriptListPair(iter->second, iter->first));
+		iter = this->items.erase(iter);
+		removed = true;
+	}
+	if (removed) this->sorter->RemovedItems();
+}
+
+/**
+ * Remove the first items in order of the current sorter type.
+ * @param count The number of items to remove.
+ * @param ascending Whether to remove the lowest or the highest items.
+ */
+void ScriptList::RemoveFirst(int32 count, bool ascending)
+{
+	if (count <= 0) return;
+	if ((size_t)count >= this->items.size()) {
+		this->RemoveItems([](int64, int64) { return true; });
+		return;
+	}
+
+	switch (this->sorter_type) {
+		default: NOT_REACHED();
+		case SORT_BY_VALUE: {
+			const ScriptListValueMap &values = this->GetValues();
+			/* Items up to and including this value/item pair are removed. */
+			ScriptListPair limit = ascending ? *std::next(values.begin(), count - 1) : *std::next(values.rbegin(), count - 1);
+			this->RemoveItems([&](int64 item, int64 value) {
+				ScriptListPair pair(value, item);
+				return ascending ? pair <= limit : pair >= limit;
+			});
+			break;
+		}
+
+		case SORT_BY_ITEM: {
+			int64 limit = ascending ? std::next(this->items.begin(), count - 1)->first : std::next(this->items.rbegin(), count - 1)->first;
+			this->RemoveItems([&](int64 item, int64) { return ascending ? item <= limit : item >= limit; });
+			break;
+		}
+	}
+}
+
+/**
+ * Change the value of an item.
+ * @param item_iter The item to change.
+ * @param value The new value.
+ */
+void ScriptList::AssignValue(ScriptListMap::iterator item_iter, int64 value)
+{
+	int64 value_old = item_iter->second;
+	if (value_old == value) return;
+
+	this->sorter->Remove(item_iter->first);
+	if (this->values_valid) {
+		this->values.erase(ScriptListPair(value_old, item_iter->first));
+		this->values.emplace(value, item_iter->first);
+	}
+	item_iter->second = value;
+}
+
 bool ScriptList::HasItem(int64 item)
 {
-	return this->items.count(item) == 1;
+	return this->items.count(item) != 0;
 }
 
 void ScriptList::Clear()
@@ -429,7 +412,8 @@ void ScriptList::Clear()
 	this->modifications++;
 
 	this->items.clear();
-	this->buckets.clear();
+	this->values.clear();
+	this->values_valid = true;
 	this->sorter->End();
 }
 
@@ -437,10 +421,14 @@ void ScriptList::AddItem(int64 item, int64 value)
 {
 	this->modifications++;
 
-	if (this->HasItem(item)) return;
+	/* Lists are mostly filled in ascending order, so try appending first. */
+	if (this->items.empty() || this->items.rbegin()->first < item) {
+		this->items.emplace_hint(this->items.end(), item, value);
+	} else if (!this->items.emplace(item, value).second) {
+		return;
+	}
 
-	this->items[item] = value;
-	this->buckets[value].insert(item);
+	if (this->values_valid) this->values.emplace(value, item);
 }
 
 void ScriptList::RemoveItem(int64 item)
@@ -450,13 +438,8 @@ void ScriptList::RemoveItem(int64 item)
 	ScriptListMap::iterator item_iter = this->items.find(item);
 	if (item_iter == this->items.end()) return;
 
-	int64 value = item_iter->second;
-
 	this->sorter->Remove(item);
-	ScriptListBucket::iterator bucket_iter = this->buckets.find(value);
-	assert(bucket_iter != this->buckets.end());
-	bucket_iter->second.erase(item);
-	if (bucket_iter->second.empty()) this->buckets.erase(bucket_iter);
+	if (this->values_valid) this->values.erase(ScriptListPair(item_iter->second, item));
 	this->items.erase(item_iter);
 }
 
@@ -507,17 +490,7 @@ bool ScriptList::SetValue(int64 item, int64 value)
 	ScriptListMap::iterator item_iter = this->items.find(item);
 	if (item_iter == this->items.end()) return false;
 
-	int64 value_old = item_iter->second;
-	if (value_old == value) return true;
-
-	this->sorter->Remove(item);
-	ScriptListBucket::iterator bucket_iter = this->buckets.find(value_old);
-	assert(bucket_iter != this->buckets.end());
-	bucket_iter->second.erase(item);
-	if (bucket_iter->second.empty()) this->buckets.erase(bucket_iter);
-	item_iter->second = value;
-	this->buckets[value].insert(item);
-
+	this->AssignValue(item_iter, value);
 	return true;
 }
 
@@ -557,16 +530,23 @@ void ScriptList::AddList(ScriptList *list)
 {
 	if (list == this) return;
 
+	this->modifications++;
+
 	if (this->IsEmpty()) {
 		/* If this is empty, we can just take the items of the other list as is. */
 		this->items = list->items;
-		this->buckets = list->buckets;
-		this->modifications++;
-	} else {
-		ScriptListMap *list_items = &list->items;
-		for (ScriptListMap::iterator iter = list_items->begin(); iter != list_items->end(); iter++) {
-			this->AddItem((*iter).first);
-			this->SetValue((*iter).first, (*iter).second);
+		this->values_valid = false;
+		return;
+	}
+
+	/* For items in both lists, the value of the other list wins. */
+	for (const auto &pair : list->items) {
+		auto iter = this->items.find(pair.first);
+		if (iter == this->items.end()) {
+			this->items.emplace(pair.first, pair.second);
+			if (this->values_valid) this->values.emplace(pair.second, pair.first);
+		} else {
+			this->AssignValue(iter, pair.second);
 		}
 	}
 }
@@ -576,7 +556,8 @@ void ScriptList::SwapList(ScriptList *list)
 	if (list == this) return;
 
 	this->items.swap(list->items);
-	this->buckets.swap(list->buckets);
+	this->values.swap(list->values);
+	Swap(this->values_valid, list->values_valid);
 	Swap(this->sorter, list->sorter);
 	Swap(this->sorter_type, list->sorter_type);
 	Swap(this->sort_ascending, list->sort_ascending);
@@ -588,170 +569,66 @@ void ScriptList::SwapList(ScriptList *list)
 
 void ScriptList::RemoveAboveValue(int64 value)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second > value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItems([&](int64, int64 v) { return v > value; });
 }
 
 void ScriptList::RemoveBelowValue(int64 value)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second < value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItems([&](int64, int64 v) { return v < value; });
 }
 
 void ScriptList::RemoveBetweenValue(int64 start, int64 end)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second > start && (*iter).second < end) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItems([&](int64, int64 v) { return v > start && v < end; });
 }
 
 void ScriptList::RemoveValue(int64 value)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second == value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItems([&](int64, int64 v) { return v == value; });
 }
 
 void ScriptList::RemoveTop(int32 count)
 {
 	this->modifications++;
 
-	if (!this->sort_ascending) {
-		this->Sort(this->sorter_type, !this->sort_ascending);
-		this->RemoveBottom(count);
-		this->Sort(this->sorter_type, !this->sort_ascending);
-		return;
-	}
-
-	switch (this->sorter_type) {
-		default: NOT_REACHED();
-		case SORT_BY_VALUE:
-			for (ScriptListBucket::iterator iter = this->buckets.begin(); iter != this->buckets.end(); iter = this->buckets.begin()) {
-				ScriptItemList *items = &(*iter).second;
-				size_t size = items->size();
-				for (ScriptItemList::iterator iter = items->begin(); iter != items->end(); iter = items->begin()) {
-					if (--count < 0) return;
-					this->RemoveItem(*iter);
-					/* When the last item is removed from the bucket, the bucket itself is removed.
-					 * This means that the iterators can be invalid after a call to RemoveItem.
-					 */
-					if (--size == 0) break;
-				}
-			}
-			break;
-
-		case SORT_BY_ITEM:
-			for (ScriptListMap::iterator iter = this->items.begin(); iter != this->items.end(); iter = this->items.begin()) {
-				if (--count < 0) return;
-				this->RemoveItem((*iter).first);
-			}
-			break;
-	}
+	this->RemoveFirst(count, this->sort_ascending);
 }
 
 void ScriptList::RemoveBottom(int32 count)
 {
 	this->modifications++;
 
-	if (!this->sort_ascending) {
-		this->Sort(this->sorter_type, !this->sort_ascending);
-		this->RemoveTop(count);
-		this->Sort(this->sorter_type, !this->sort_ascending);
-		return;
-	}
-
-	switch (this->sorter_type) {
-		default: NOT_REACHED();
-		case SORT_BY_VALUE:
-			for (ScriptListBucket::reverse_iterator iter = this->buckets.rbegin(); iter != this->buckets.rend(); iter = this->buckets.rbegin()) {
-				ScriptItemList *items = &(*iter).second;
-				size_t size = items->size();
-				for (ScriptItemList::reverse_iterator iter = items->rbegin(); iter != items->rend(); iter = items->rbegin()) {
-					if (--count < 0) return;
-					this->RemoveItem(*iter);
-					/* When the last item is removed from the bucket, the bucket itself is removed.
-					 * This means that the iterators can be invalid after a call to RemoveItem.
-					 */
-					if (--size == 0) break;
-				}
-			}
-			break;
-
-		case SORT_BY_ITEM:
-			for (ScriptListMap::reverse_iterator iter = this->items.rbegin(); iter != this->items.rend(); iter = this->items.rbegin()) {
-				if (--count < 0) return;
-				this->RemoveItem((*iter).first);
-			}
-			break;
-	}
+	this->RemoveFirst(count, !this->sort_ascending);
 }
 
 void ScriptList::RemoveList(ScriptList *list)
 {
-	this->modifications++;
-
 	if (list == this) {
-		Clear();
-	} else {
-		ScriptListMap *list_items = &list->items;
-		for (ScriptListMap::iterator iter = list_items->begin(); iter != list_items->end(); iter++) {
-			this->RemoveItem((*iter).first);
-		}
+		this->Clear();
+		return;
 	}
+
+	this->RemoveItems([&](int64 item, int64) { return list->HasItem(item); });
 }
 
 void ScriptList::KeepAboveValue(int64 value)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second <= value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItems([&](int64, int64 v) { return v <= value; });
 }
 
 void ScriptList::KeepBelowValue(int64 value)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second >= value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItems([&](int64, int64 v) { return v >= value; });
 }
 
 void ScriptList::KeepBetweenValue(int64 start, int64 end)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second <= start || (*iter).second >= end) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItems([&](int64, int64 v) { return v <= start || v >= end; });
 }
 
 void ScriptList::KeepValue(int64 value)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second != value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItems([&](int64, int64 v) { return v != value; });
 }
 
 void ScriptList::KeepTop(int32 count)
@@ -772,12 +649,7 @@ void ScriptList::KeepList(ScriptList *list)
 {
 	if (list == this) return;
 
-	this->modifications++;
-
-	ScriptList tmp;
-	tmp.AddList(this);
-	tmp.RemoveList(list);
-	this->RemoveList(&tmp);
+	this->RemoveItems([&](int64 item, int64) { return !list->HasItem(item); });
 }
 
 SQInteger ScriptList::_get(HSQUIRRELVM vm)
@@ -869,14 +741,19 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 	/* Push the function to call */
 	sq_push(vm, 2);
 
-	for (ScriptListMap::iterator iter = this->items.begin(); iter != this->items.end(); iter++) {
+	/* While the list is being iterated, the sorter has to be told about every changed value.
+	 * Otherwise setting all values and then rebuilding the value ordering once is a lot faster. */
+	bool iterating = !this->sorter->IsEnd();
+	if (!iterating) this->values_valid = false;
+
+	for (ScriptListMap::iterator item_iter = this->items.begin(); item_iter != this->items.end(); item_iter++) {
 		/* Check for changing of items. */
 		int previous_modification_count = this->modifications;
 
 		/* Push the root table as instance object, this is what squirrel does for meta-functions. */
 		sq_pushroottable(vm);
 		/* Push all arguments for the valuator function. */
-		sq_pushinteger(vm, (*iter).first);
+		sq_pushinteger(vm, item_iter->first);
 		for (int i = 0; i < nparam - 1; i++) {
 			sq_push(vm, i + 3);
 		}
@@ -930,7 +807,11 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 			return sq_throwerror(vm, "modifying valuated list outside of valuator function");
 		}
 
-		this->SetValue((*iter).first, value);
+		if (iterating) {
+			this->AssignValue(item_iter, value);
+		} else {
+			item_iter->second = value;
+		}
 
 		/* Pop the return value. */
 		sq_poptop(vm);
@@ -947,3 +828,38 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 	ScriptObject::SetAllowDoCommand(backup_allow);
 	return 0;
 }
+
+void ScriptList::ValuateNative(NativeValuator valuator, int64 param)
+{
+	if (valuator >= VALUATE_END) return;
+
+	this->modifications++;
+
+	/* See Valuate for why the values are only set directly when not iterating. */
+	bool iterating = !this->sorter->IsEnd();
+	if (!iterating) this->values_valid = false;
+
+	for (ScriptListMap::iterator item_iter = this->items.begin(); item_iter != this->items.end(); item_iter++) {
+		const int64 item = item_iter->first;
+		int64 value;
+		switch (valuator) {
+			case VALUATE_TILE_DISTANCE_MANHATTAN:     value = ScriptTile::GetDistanceManhattanToTile((TileIndex)item, (TileIndex)param); break;
+			case VALUATE_TILE_DISTANCE_SQUARE:        value = ScriptTile::GetDistanceSquareToTile((TileIndex)item, (TileIndex)param); break;
+			case VALUATE_TILE_BUILDABLE:              value = ScriptTile::IsBuildable((TileIndex)item) ? 1 : 0; break;
+			case VALUATE_TILE_SLOPE:                  value = ScriptTile::GetSlope((TileIndex)item); break;
+			case VALUATE_TILE_MAX_HEIGHT:             value = ScriptTile::GetMaxHeight((TileIndex)item); break;
+			case VALUATE_TILE_OWNER:                  value = ScriptTile::GetOwner((TileIndex)item); break;
+			case VALUATE_INDUSTRY_DISTANCE_MANHATTAN: value = ScriptIndustry::GetDistanceManhattanToTile((IndustryID)item, (TileIndex)param); break;
+			case VALUATE_INDUSTRY_PRODUCTION:         value = ScriptIndustry::GetLastMonthProduction((IndustryID)item, (CargoID)param); break;
+			default: NOT_REACHED();
+		}
+		if (iterating) {
+			this->AssignValue(item_iter, value);
+		} else {
+			item_iter->second = value;
+		}
+	}
+
+	/* A native valuation is cheap, but not free. */
+	ScriptObject::GetActiveInstance()->DecreaseOps((int)std::min<size_t>(this->items.size(), INT32_MAX));
+}
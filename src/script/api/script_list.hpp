@@ -34,6 +34,19 @@ public:
 	/** Sort descending */
 	static const bool SORT_DESCENDING = false;
 
+	/** Built-in valuators, see ValuateNative(). */
+	enum NativeValuator {
+		VALUATE_TILE_DISTANCE_MANHATTAN,     ///< Manhattan distance of the tile to the tile given as parameter.
+		VALUATE_TILE_DISTANCE_SQUARE,        ///< Square distance of the tile to the tile given as parameter.
+		VALUATE_TILE_BUILDABLE,              ///< Whether the tile is buildable, see ScriptTile::IsBuildable.
+		VALUATE_TILE_SLOPE,                  ///< Slope of the tile, see ScriptTile::GetSlope.
+		VALUATE_TILE_MAX_HEIGHT,             ///< Height of the highest corner of the tile, see ScriptTile::GetMaxHeight.
+		VALUATE_TILE_OWNER,                  ///< Owner of the tile, see ScriptTile::GetOwner.
+		VALUATE_INDUSTRY_DISTANCE_MANHATTAN, ///< Manhattan distance of the industry to the tile given as parameter.
+		VALUATE_INDUSTRY_PRODUCTION,         ///< Last month's production of the industry of the cargo given as parameter.
+		VALUATE_END,                         ///< End marker, not a valid valuator.
+	};
+
 private:
 	ScriptListSorter *sorter;     ///< Sorting algorithm
 	SorterType sorter_type;       ///< Sorting type
@@ -42,12 +55,11 @@ private:
 	int modifications;            ///< Number of modification that has been done. To prevent changing data while valuating.
 
 public:
-	typedef std::set<int64> ScriptItemList;                   ///< The list of items inside the bucket
-	typedef std::map<int64, ScriptItemList> ScriptListBucket; ///< The bucket list per value
-	typedef std::map<int64, int64> ScriptListMap;             ///< List per item
+	typedef std::pair<int64, int64> ScriptListPair;       ///< A value and its item.
+	typedef std::map<int64, int64> ScriptListMap;         ///< List per item
+	typedef std::set<ScriptListPair> ScriptListValueMap;  ///< Value/item pairs, sorted by value and then item.
 
 	ScriptListMap items;           ///< The items in the list
-	ScriptListBucket buckets;      ///< The items in the list, sorted by value
 
 	ScriptList();
 	~ScriptList();
@@ -286,6 +298,29 @@ public:
 	 */
 	void Valuate(void *valuator_function, int params, ...);
 #endif /* DOXYGEN_API */
+
+	/**
+	 * Give all items a value using one of the built-in valuators. This is a lot
+	 *  faster than calling Valuate() with the equivalent API function.
+	 * @param valuator The valuator to use.
+	 * @param param The parameter of the valuator, if it needs one; otherwise ignored.
+	 * @pre valuator < VALUATE_END.
+	 * @note Example:
+	 *  list.ValuateNative(ScriptList.VALUATE_TILE_DISTANCE_MANHATTAN, home_tile);
+	 *  list.ValuateNative(ScriptList.VALUATE_TILE_BUILDABLE, 0);
+	 */
+	void ValuateNative(NativeValuator valuator, int64 param);
+
+private:
+	friend class ScriptListSorter;
+
+	ScriptListValueMap values; ///< The items in the list, sorted by value; only valid when #values_valid.
+	bool values_valid;         ///< Whether #values matches #items.
+
+	const ScriptListValueMap &GetValues();
+	template <typename Tpredicate> void RemoveItems(Tpredicate predicate);
+	void RemoveFirst(int32 count, bool ascending);
+	void AssignValue(ScriptListMap::iterator item_iter, int64 value);
 };
 
 #endif /* SCRIPT_LIST_HPP */
@@ -0,0 +1,348 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file script_pathfinder.cpp Implementation of ScriptPathfinder. */
+
+#include "../../stdafx.h"
+#include "script_pathfinder.hpp"
+#include "script_map.hpp"
+#include "../script_instance.hpp"
+#include "../../rail.h"
+#include "../../road_map.h"
+#include "../../rail_map.h"
+#include "../../tunnelbridge.h"
+#include "../../tunnelbridge_map.h"
+#include "../../tile_cmd.h"
+#include <algorithm>
+
+#include "../../safeguards.h"
+
+static const uint PATHFINDER_HASH_BITS = 12; ///< Number of bits of the hash of the open and closed lists.
+static const uint PATHFINDER_HASH_SIZE = 1 << PATHFINDER_HASH_BITS;
+static const uint PATHFINDER_HASH_HALFMASK = (1 << (PATHFINDER_HASH_BITS / 2)) - 1;
+
+/** Indices in #AyStarNode::user_data. */
+enum PathfinderNodeData {
+	PND_SKIPPED_TILES = 0, ///< Number of tiles of a bridge or tunnel passed to reach this node.
+	PND_NEW_TILE = 1,      ///< Whether infrastructure needs to be built on this node.
+};
+
+/**
+ * Hash a node of the search.
+ * @param key1 The tile of the node.
+ * @param key2 The trackdir of the node.
+ * @return The hash of the node.
+ */
+static uint PathfinderHash(uint key1, uint key2)
+{
+	uint part1 = TileX(key1) & PATHFINDER_HASH_HALFMASK;
+	uint part2 = TileY(key1) & PATHFINDER_HASH_HALFMASK;
+
+	return ((part1 << (PATHFINDER_HASH_BITS / 2) | part2) + (PATHFINDER_HASH_SIZE * key2 / TRACKDIR_END)) % PATHFINDER_HASH_SIZE;
+}
+
+ScriptPathfinder::ScriptPathfinder(ScriptPathfinder::PathfinderType type) :
+	type(type),
+	status(SS_SEARCHING),
+	started(false),
+	build_new(true),
+	max_nodes(10000),
+	explored(0)
+{
+	this->costs[COST_TILE] = 100;
+	this->costs[COST_NEW_TILE] = 100;
+	this->costs[COST_TURN] = 50;
+	this->costs[COST_SLOPE] = 100;
+	this->costs[COST_BRIDGE] = 50;
+
+	this->aystar.CalculateG = &ScriptPathfinder::CalculateG;
+	this->aystar.CalculateH = &ScriptPathfinder::CalculateH;
+	this->aystar.GetNeighbours = &ScriptPathfinder::GetNeighbours;
+	this->aystar.EndNodeCheck = &ScriptPathfinder::EndNodeCheck;
+	this->aystar.FoundEndNode = &ScriptPathfinder::FoundEndNode;
+	this->aystar.user_path = nullptr;
+	this->aystar.user_target = nullptr;
+	this->aystar.user_data = this;
+	this->aystar.loops_per_tick = 0;
+	this->aystar.max_path_cost = 0;
+	this->aystar.max_search_nodes = 0;
+	this->aystar.num_neighbours = 0;
+	this->aystar.Init(PathfinderHash, PATHFINDER_HASH_SIZE);
+}
+
+ScriptPathfinder::~ScriptPathfinder()
+{
+	this->aystar.Free();
+}
+
+void ScriptPathfinder::AddStart(TileIndex tile)
+{
+	if (!ScriptMap::IsValidTile(tile) || this->started) return;
+
+	this->starts.push_back(tile);
+}
+
+void ScriptPathfinder::AddGoal(TileIndex tile)
+{
+	if (!ScriptMap::IsValidTile(tile) || this->started) return;
+
+	this->goals.push_back(tile);
+}
+
+void ScriptPathfinder::SetCost(CostType cost_type, SQInteger cost)
+{
+	if (cost_type >= COST_END || cost < 0 || this->started) return;
+
+	this->costs[cost_type] = (int32)std::min<SQInteger>(cost, INT16_MAX);
+}
+
+SQInteger ScriptPathfinder::GetCost(CostType cost_type)
+{
+	if (cost_type >= COST_END) return -1;
+
+	return this->costs[cost_type];
+}
+
+void ScriptPathfinder::SetBuildNew(bool build_new)
+{
+	if (this->started) return;
+
+	this->build_new = build_new;
+}
+
+void ScriptPathfinder::SetMaxNodes(SQInteger max_nodes)
+{
+	if (max_nodes < 0 || this->started) return;
+
+	this->max_nodes = (uint)std::min<SQInteger>(max_nodes, UINT32_MAX);
+}
+
+ScriptPathfinder::SearchStatus ScriptPathfinder::FindPath(SQInteger iterations)
+{
+	if (iterations <= 0 || this->status != SS_SEARCHING) return this->status;
+	/* Do not explore more nodes than the script may run operations before it is suspended. */
+	SQInteger ops_left = ScriptObject::GetActiveInstance()->GetOpsTillSuspend();
+	uint max_loops = (uint)Clamp<SQInteger>(std::min<SQInteger>(iterations, ops_left / OPS_PER_NODE), 1, UINT16_MAX);
+
+	if (!this->started) {
+		this->started = true;
+		std::sort(this->goals.begin(), this->goals.end());
+		this->aystar.max_search_nodes = this->max_nodes;
+
+		for (TileIndex tile : this->starts) {
+			/* The direction a start tile is entered in is unknown, so try them all. */
+			for (DiagDirection dir = DIAGDIR_BEGIN; dir < DIAGDIR_END; dir++) {
+				AyStarNode start;
+				start.tile = tile;
+				start.direction = DiagDirToDiagTrackdir(dir);
+				start.user_data[PND_SKIPPED_TILES] = 0;
+				start.user_data[PND_NEW_TILE] = 0;
+				this->aystar.AddStartNode(&start, 0);
+			}
+		}
+	}
+
+	int result = AYSTAR_STILL_BUSY;
+	uint loops = 0;
+	while (result == AYSTAR_STILL_BUSY && loops < max_loops) {
+		result = this->aystar.Loop();
+		loops++;
+	}
+	this->explored += loops;
+
+	switch (result) {
+		case AYSTAR_STILL_BUSY: break;
+		case AYSTAR_FOUND_END_NODE: this->status = SS_FOUND; break;
+		default: this->status = SS_NO_PATH; break;
+	}
+	if (this->status != SS_SEARCHING) this->aystar.Clear();
+
+	ScriptObject::GetActiveInstance()->DecreaseOps(loops * OPS_PER_NODE);
+
+	return this->status;
+}
+
+ScriptPathfinder::SearchStatus ScriptPathfinder::GetStatus()
+{
+	return this->status;
+}
+
+SQInteger ScriptPathfinder::GetExploredNodes()
+{
+	return this->explored;
+}
+
+ScriptList *ScriptPathfinder::GetPath()
+{
+	if (this->status != SS_FOUND) return nullptr;
+
+	ScriptList *list = new ScriptList();
+	for (uint i = 0; i < this->path.size(); i++) {
+		list->AddItem(this->path[i], i);
+	}
+	return list;
+}
+
+/**
+ * Check whether a tile is one of the goals.
+ * @param tile The tile to check.
+ * @return True iff the route may end at the tile.
+ */
+bool ScriptPathfinder::IsGoal(TileIndex tile) const
+{
+	return std::binary_search(this->goals.begin(), this->goals.end(), tile);
+}
+
+/**
+ * Get the trackdirs of existing infrastructure that can be used when entering a tile.
+ * @param tile The tile to enter.
+ * @param enterdir The direction the tile is entered in.
+ * @return The usable trackdirs.
+ */
+TrackdirBits ScriptPathfinder::GetExistingTrackdirs(TileIndex tile, DiagDirection enterdir) const
+{
+	TrackStatus ts;
+	switch (this->type) {
+		case PT_ROAD:
+			ts = GetTileTrackStatus(tile, TRANSPORT_ROAD, GetRoadTramType(ScriptObject::GetRoadType()));
+			break;
+
+		case PT_RAIL:
+			ts = GetTileTrackStatus(tile, TRANSPORT_RAIL, 0);
+			if (ts != 0 && ScriptObject::GetRailType() != INVALID_RAILTYPE && !IsCompatibleRail(ScriptObject::GetRailType(), GetTileRailType(tile))) return TRACKDIR_BIT_NONE;
+			break;
+
+		case PT_WATER:
+			ts = GetTileTrackStatus(tile, TRANSPORT_WATER, 0);
+			break;
+
+		default: NOT_REACHED();
+	}
+
+	return TrackStatusToTrackdirBits(ts) & DiagdirReachesTrackdirs(enterdir);
+}
+
+/**
+ * Check whether infrastructure could be built on, or added to, a tile.
+ * This does not take ownership or local authority into account.
+ * @param tile The tile to check.
+ * @return True iff the search may build on the tile.
+ */
+bool ScriptPathfinder::CanBuildOn(TileIndex tile) const
+{
+	if (!this->build_new) return false;
+
+	Slope slope = GetTileSlope(tile);
+	if (IsSteepSlope(slope)) return false;
+	if (this->type == PT_WATER && slope != SLOPE_FLAT) return false;
+
+	switch (GetTileType(tile)) {
+		case MP_CLEAR:
+		case MP_TREES:
+			return true;
+
+		case MP_ROAD:
+			return this->type == PT_ROAD && IsNormalRoad(tile);
+
+		case MP_RAILWAY:
+			return this->type == PT_RAIL && IsPlainRail(tile);
+
+		default:
+			return false;
+	}
+}
+
+/* static */ int32 ScriptPathfinder::EndNodeCheck(const AyStar *aystar, const OpenListNode *current)
+{
+	const ScriptPathfinder *pf = (const ScriptPathfinder *)aystar->user_data;
+	return pf->IsGoal(current->path.node.tile) ? AYSTAR_FOUND_END_NODE : AYSTAR_DONE;
+}
+
+/* static */ int32 ScriptPathfinder::CalculateG(AyStar *aystar, AyStarNode *current, OpenListNode *parent)
+{
+	const ScriptPathfinder *pf = (const ScriptPathfinder *)aystar->user_data;
+
+	uint skipped = current->user_data[PND_SKIPPED_TILES];
+	int32 cost = pf->costs[COST_TILE] * (1 + skipped) + pf->costs[COST_BRIDGE] * skipped;
+	if (current->user_data[PND_NEW_TILE] != 0) cost += pf->costs[COST_NEW_TILE];
+	if (current->direction != parent->path.node.direction) cost += pf->costs[COST_TURN];
+	if (!IsTileFlat(current->tile)) cost += pf->costs[COST_SLOPE];
+	return cost;
+}
+
+/* static */ int32 ScriptPathfinder::CalculateH(AyStar *aystar, AyStarNode *current, OpenListNode *parent)
+{
+	const ScriptPathfinder *pf = (const ScriptPathfinder *)aystar->user_data;
+
+	uint min_distance = UINT_MAX;
+	for (TileIndex goal : pf->goals) {
+		min_distance = std::min(min_distance, DistanceManhattan(goal, current->tile));
+	}
+	return min_distance == UINT_MAX ? 0 : min_distance * pf->costs[COST_TILE];
+}
+
+/* static */ void ScriptPathfinder::GetNeighbours(AyStar *aystar, OpenListNode *current)
+{
+	const ScriptPathfinder *pf = (const ScriptPathfinder *)aystar->user_data;
+	TileIndex tile = current->path.node.tile;
+	DiagDirection enterdir = TrackdirToExitdir(current->path.node.direction);
+
+	aystar->num_neighbours = 0;
+
+	/* Directions the tile can be left in over existing infrastructure. */
+	TrackdirBits trackdirs = pf->GetExistingTrackdirs(tile, enterdir);
+	uint8 exitdirs = 0;
+	for (uint td : SetBitIterator(trackdirs)) SetBit(exitdirs, TrackdirToExitdir((Trackdir)td));
+
+	/* New infrastructure can go anywhere but back; start tiles can be left in any direction. */
+	if (current->path.parent == nullptr || pf->CanBuildOn(tile)) {
+		exitdirs |= 0xF;
+		if (current->path.parent != nullptr) ClrBit(exitdirs, ReverseDiagDir(enterdir));
+	}
+
+	for (DiagDirection exitdir = DIAGDIR_BEGIN; exitdir < DIAGDIR_END; exitdir++) {
+		if (!HasBit(exitdirs, exitdir)) continue;
+
+		TileIndex next;
+		uint skipped = 0;
+		if (IsTileType(tile, MP_TUNNELBRIDGE) && GetTunnelBridgeDirection(tile) == exitdir && trackdirs != TRACKDIR_BIT_NONE) {
+			/* Follow the bridge or tunnel to its other end. */
+			next = GetOtherTunnelBridgeEnd(tile);
+			skipped = GetTunnelBridgeLength(tile, next);
+		} else {
+			TileIndexDiffC diff = TileIndexDiffCByDiagDir(exitdir);
+			next = TileAddWrap(tile, diff.x, diff.y);
+			if (next == INVALID_TILE) continue;
+		}
+
+		bool new_tile;
+		if (pf->GetExistingTrackdirs(next, exitdir) != TRACKDIR_BIT_NONE) {
+			new_tile = false;
+		} else if (skipped == 0 && (pf->CanBuildOn(next) || pf->IsGoal(next))) {
+			new_tile = true;
+		} else {
+			continue;
+		}
+
+		AyStarNode &neighbour = aystar->neighbours[aystar->num_neighbours++];
+		neighbour.tile = next;
+		neighbour.direction = DiagDirToDiagTrackdir(exitdir);
+		neighbour.user_data[PND_SKIPPED_TILES] = skipped;
+		neighbour.user_data[PND_NEW_TILE] = new_tile ? 1 : 0;
+	}
+}
+
+/* static */ void ScriptPathfinder::FoundEndNode(AyStar *aystar, OpenListNode *current)
+{
+	ScriptPathfinder *pf = (ScriptPathfinder *)aystar->user_data;
+
+	pf->path.clear();
+	for (const PathNode *node = &current->path; node != nullptr; node = node->parent) {
+		pf->path.push_back(node->node.tile);
+	}
+	std::reverse(pf->path.begin(), pf->path.end());
+}
@@ -0,0 +1,175 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file script_pathfinder.hpp Native route searching for scripts. */
+
+#ifndef SCRIPT_PATHFINDER_HPP
+#define SCRIPT_PATHFINDER_HPP
+
+#include "script_list.hpp"
+#include "../../pathfinder/npf/aystar.h"
+#include <vector>
+
+/**
+ * Class that searches a route over the map natively.
+ *  The search is incremental: create the pathfinder, add start and goal
+ *  tiles, and call FindPath() every now and then until it no longer
+ *  returns SS_SEARCHING. Every explored node is charged to the script
+ *  as a few operations.
+ * @note The map may change between two calls to FindPath(); the route
+ *  found is only valid at the moment it was found.
+ * @api ai game
+ */
+class ScriptPathfinder : public ScriptObject {
+public:
+	/**
+	 * The kind of infrastructure to search a route over.
+	 */
+	enum PathfinderType {
+		PT_ROAD,  ///< Search over road, of the currently selected road type, and land road can be built on.
+		PT_RAIL,  ///< Search over rail, compatible with the currently selected rail type, and land rail can be built on.
+		PT_WATER, ///< Search over water, and flat land canals can be built on.
+	};
+
+	/**
+	 * The state of the search.
+	 */
+	enum SearchStatus {
+		SS_SEARCHING, ///< The search has not finished yet.
+		SS_FOUND,     ///< A route has been found, see GetPath().
+		SS_NO_PATH,   ///< No route exists or the node limit was reached.
+	};
+
+	/**
+	 * The costs that can be configured.
+	 */
+	enum CostType {
+		COST_TILE,     ///< Cost of every tile of the route.
+		COST_NEW_TILE, ///< Extra cost of a tile that does not have usable infrastructure yet.
+		COST_TURN,     ///< Extra cost of changing direction.
+		COST_SLOPE,    ///< Extra cost of a sloped tile.
+		COST_BRIDGE,   ///< Extra cost of every tile of an existing bridge or tunnel that is passed.
+		COST_END,      ///< End marker, not a valid cost type.
+	};
+
+	/**
+	 * Create a new route search.
+	 * @param type The kind of infrastructure to search over.
+	 */
+	ScriptPathfinder(ScriptPathfinder::PathfinderType type);
+
+	~ScriptPathfinder();
+
+	/**
+	 * Add a tile the route may start at.
+	 * @param tile The tile to start at.
+	 * @pre ScriptMap::IsValidTile(tile).
+	 * @pre GetStatus() == SS_SEARCHING and FindPath() has not been called yet.
+	 */
+	void AddStart(TileIndex tile);
+
+	/**
+	 * Add a tile the route may end at.
+	 * @param tile The tile to end at.
+	 * @pre ScriptMap::IsValidTile(tile).
+	 * @pre GetStatus() == SS_SEARCHING and FindPath() has not been called yet.
+	 */
+	void AddGoal(TileIndex tile);
+
+	/**
+	 * Set one of the costs of the search.
+	 * @param cost_type The cost to change.
+	 * @param cost The new cost.
+	 * @pre cost_type < COST_END.
+	 * @pre cost >= 0.
+	 * @pre FindPath() has not been called yet.
+	 */
+	void SetCost(CostType cost_type, SQInteger cost);
+
+	/**
+	 * Get one of the costs of the search.
+	 * @param cost_type The cost to get.
+	 * @pre cost_type < COST_END.
+	 * @return The cost.
+	 */
+	SQInteger GetCost(CostType cost_type);
+
+	/**
+	 * Set whether the route may use tiles that still need infrastructure
+	 *  to be built, or only existing infrastructure. Defaults to true.
+	 * @param build_new True iff tiles without infrastructure may be used.
+	 * @pre FindPath() has not been called yet.
+	 */
+	void SetBuildNew(bool build_new);
+
+	/**
+	 * Set the maximum number of nodes to explore before giving up.
+	 * @param max_nodes The maximum number of nodes, 0 for no limit.
+	 * @pre max_nodes >= 0.
+	 * @pre FindPath() has not been called yet.
+	 */
+	void SetMaxNodes(SQInteger max_nodes);
+
+	/**
+	 * Continue searching for a route.
+	 * @param iterations The maximum number of nodes to explore in this call.
+	 * @pre iterations > 0.
+	 * @return The state of the search after this call.
+	 * @note Every explored node costs the script a few operations. No more nodes
+	 *  are explored than the script has operations left before it is suspended,
+	 *  though always at least one.
+	 */
+	SearchStatus FindPath(SQInteger iterations);
+
+	/**
+	 * Get the state of the search.
+	 * @return The state of the search.
+	 */
+	SearchStatus GetStatus();
+
+	/**
+	 * Get the number of nodes explored so far.
+	 * @return The number of explored nodes.
+	 */
+	SQInteger GetExploredNodes();
+
+	/**
+	 * Get the route that was found.
+	 * @pre GetStatus() == SS_FOUND.
+	 * @return A list with the tiles of the route as items, and as value the
+	 *  position of the tile in the route, starting at 0 for the start tile.
+	 * @note Of bridges and tunnels only the heads are in the list.
+	 */
+	ScriptList *GetPath();
+
+private:
+	static const uint OPS_PER_NODE = 5; ///< Operations charged for every explored node.
+
+	AyStar aystar;                    ///< The search itself.
+	PathfinderType type;              ///< Kind of infrastructure to search over.
+	SearchStatus status;              ///< State of the search.
+	bool started;                     ///< Whether the search has been started.
+	bool build_new;                   ///< Whether tiles without infrastructure may be used.
+	uint max_nodes;                   ///< Maximum number of nodes to explore.
+	uint explored;                    ///< Number of explored nodes so far.
+	int32 costs[COST_END];            ///< The costs of the search.
+	std::vector<TileIndex> starts;    ///< Tiles the route may start at.
+	std::vector<TileIndex> goals;     ///< Tiles the route may end at.
+	std::vector<TileIndex> path;      ///< The route found, from start to goal.
+
+	bool IsGoal(TileIndex tile) const;
+	TrackdirBits GetExistingTrackdirs(TileIndex tile, DiagDirection enterdir) const;
+	bool CanBuildOn(TileIndex tile) const;
+
+	static int32 EndNodeCheck(const AyStar *aystar, const OpenListNode *current);
+	static int32 CalculateG(AyStar *aystar, AyStarNode *current, OpenListNode *parent);
+	static int32 CalculateH(AyStar *aystar, AyStarNode *current, OpenListNode *parent);
+	static void GetNeighbours(AyStar *aystar, OpenListNode *current);
+	static void FoundEndNode(AyStar *aystar, OpenListNode *current);
+};
+
+#endif /* SCRIPT_PATHFINDER_HPP */
@@ -10,6 +10,8 @@
 #include "../../stdafx.h"
 #include "script_tilelist.hpp"
 #include "script_industry.hpp"
+#include "script_tile.hpp"
+#include "../script_instance.hpp"
 #include "../../industry.h"
 #include "../../station_base.h"
 
@@ -47,6 +49,59 @@ void ScriptTileList::RemoveTile(TileIndex tile)
 	this->RemoveItem(tile);
 }
 
+ScriptTileList_Attributes::ScriptTileList_Attributes(TileIndex tile_from, TileIndex tile_to, SQInteger attributes)
+{
+	if (!::IsValidTile(tile_from)) return;
+	if (!::IsValidTile(tile_to)) return;
+
+	TileArea ta(tile_from, tile_to);
+	/* The tiles come in ascending order, so every item is simply appended. */
+	for (TileIndex t : ta) this->AddItem(t, GetTileAttributes(t, attributes));
+
+	ScriptObject::GetActiveInstance()->DecreaseOps(ta.w * ta.h);
+}
+
+/**
+ * Get the packed attributes of a single tile.
+ * @param tile The tile to get the attributes of.
+ * @param attributes The attributes to get.
+ * @return The packed attributes.
+ */
+/* static */ int64 ScriptTileList_Attributes::GetTileAttributes(TileIndex tile, SQInteger attributes)
+{
+	int64 value = 0;
+
+	if ((attributes & (TA_HEIGHT | TA_SLOPE)) != 0) {
+		/* Height and slope come from the same map bits. */
+		int z;
+		::Slope slope = ::GetTileSlope(tile, &z);
+		if ((attributes & TA_HEIGHT) != 0) value |= (int64)(z + ::GetSlopeMaxZ(slope)) << SHIFT_HEIGHT;
+		if ((attributes & TA_SLOPE) != 0) value |= (int64)slope << SHIFT_SLOPE;
+	}
+	if ((attributes & TA_OWNER) != 0) value |= (int64)(uint16)ScriptTile::GetOwner(tile) << SHIFT_OWNER;
+	if ((attributes & TA_BUILDABLE) != 0 && ScriptTile::IsBuildable(tile)) value |= (int64)1 << SHIFT_BUILDABLE;
+	if ((attributes & TA_TERRAIN) != 0) value |= (int64)ScriptTile::GetTerrainType(tile) << SHIFT_TERRAIN;
+	if ((attributes & TA_TOWN_AUTHORITY) != 0) value |= (int64)ScriptTile::GetTownAuthority(tile) << SHIFT_TOWN_AUTHORITY;
+
+	return value;
+}
+
+/* static */ SQInteger ScriptTileList_Attributes::GetAttribute(SQInteger value, TileAttribute attribute)
+{
+	switch (attribute) {
+		case TA_HEIGHT:         return GB(value, SHIFT_HEIGHT, 8);
+		case TA_SLOPE:          return GB(value, SHIFT_SLOPE, 8);
+		case TA_OWNER: {
+			uint16 owner = GB(value, SHIFT_OWNER, 16);
+			return owner == 0xFFFF ? (SQInteger)ScriptCompany::COMPANY_INVALID : owner;
+		}
+		case TA_BUILDABLE:      return GB(value, SHIFT_BUILDABLE, 1);
+		case TA_TERRAIN:        return GB(value, SHIFT_TERRAIN, 3);
+		case TA_TOWN_AUTHORITY: return GB(value, SHIFT_TOWN_AUTHORITY, 16);
+		default:                return -1;
+	}
+}
+
 /**
  * Helper to get list of tiles that will cover an industry's production or acceptance.
  * @param i Industry in question
@@ -53,6 +53,68 @@ public:
 	void RemoveTile(TileIndex tile);
 };
 
+/**
+ * Creates a list of all tiles of a rectangle, with as value a number of
+ *  attributes of the tile packed together. This is a lot faster than
+ *  asking the attributes of every tile one by one.
+ * The attributes are packed in the value as follows:
+ * <ul>
+ *  <li>bits 0 - 7: TA_HEIGHT, see ScriptTile::GetMaxHeight.</li>
+ *  <li>bits 8 - 15: TA_SLOPE, see ScriptTile::GetSlope.</li>
+ *  <li>bits 16 - 31: TA_OWNER, see ScriptTile::GetOwner; COMPANY_INVALID is stored as 0xFFFF.</li>
+ *  <li>bit 32: TA_BUILDABLE, see ScriptTile::IsBuildable.</li>
+ *  <li>bits 33 - 35: TA_TERRAIN, see ScriptTile::GetTerrainType.</li>
+ *  <li>bits 40 - 55: TA_TOWN_AUTHORITY, see ScriptTile::GetTownAuthority.</li>
+ * </ul>
+ * Attributes that were not asked for are 0. Use GetAttribute to get an
+ *  attribute from a value.
+ * @note Creating the list costs one operation per tile.
+ * @api ai game
+ * @ingroup ScriptList
+ */
+class ScriptTileList_Attributes : public ScriptTileList {
+public:
+	/**
+	 * The attributes of a tile that can be put in the list.
+	 */
+	enum TileAttribute {
+		TA_HEIGHT         = 1 << 0, ///< The maximum height of the tile.
+		TA_SLOPE          = 1 << 1, ///< The slope of the tile.
+		TA_OWNER          = 1 << 2, ///< The owner of the tile.
+		TA_BUILDABLE      = 1 << 3, ///< Whether the tile is buildable.
+		TA_TERRAIN        = 1 << 4, ///< The terrain type of the tile.
+		TA_TOWN_AUTHORITY = 1 << 5, ///< The town that has the local authority over the tile.
+	};
+
+	/**
+	 * @param tile_from One corner of the rectangle.
+	 * @param tile_to The other corner of the rectangle.
+	 * @param attributes The attributes to get of every tile, any combination of TileAttribute.
+	 * @pre ScriptMap::IsValidTile(tile_from).
+	 * @pre ScriptMap::IsValidTile(tile_to).
+	 */
+	ScriptTileList_Attributes(TileIndex tile_from, TileIndex tile_to, SQInteger attributes);
+
+	/**
+	 * Get a single attribute from the value of a tile in this list.
+	 * @param value The value of a tile in this list.
+	 * @param attribute The attribute to get, one single TileAttribute.
+	 * @return The attribute, in the same form as the ScriptTile function it refers to returns it,
+	 *  or -1 if the attribute is not a single TileAttribute.
+	 */
+	static SQInteger GetAttribute(SQInteger value, TileAttribute attribute);
+
+private:
+	static const uint SHIFT_HEIGHT = 0;          ///< Position of #TA_HEIGHT in the value.
+	static const uint SHIFT_SLOPE = 8;           ///< Position of #TA_SLOPE in the value.
+	static const uint SHIFT_OWNER = 16;          ///< Position of #TA_OWNER in the value.
+	static const uint SHIFT_BUILDABLE = 32;      ///< Position of #TA_BUILDABLE in the value.
+	static const uint SHIFT_TERRAIN = 33;        ///< Position of #TA_TERRAIN in the value.
+	static const uint SHIFT_TOWN_AUTHORITY = 40; ///< Position of #TA_TOWN_AUTHORITY in the value.
+
+	static int64 GetTileAttributes(TileIndex tile, SQInteger attributes);
+};
+
 /**
  * Creates a list of tiles that will accept cargo for the given industry.
  * @note If a simular industry is close, it might happen that this industry receives the cargo.
@@ -25,6 +25,7 @@
 
 #include "../company_base.h"
 #include "../company_func.h"
+#include "../date_func.h"
 #include "../fileio_func.h"
 #include "../league_type.h"
 #include "../misc/endian_buffer.hpp"
@@ -58,10 +59,16 @@ ScriptInstance::ScriptInstance(const char *APIName) :
 	is_started(false),
 	is_dead(false),
 	is_save_data_on_stack(false),
+	save_data_valid(false),
+	cache_save_data(false),
 	suspend(0),
 	is_paused(false),
 	in_shutdown(false),
-	callback(nullptr)
+	callback(nullptr),
+	last_memory_stats(),
+	allocation_sample(0),
+	allocation_sample_tick(_tick_counter),
+	allocations_per_day(0)
 {
 	this->storage = new ScriptStorage();
 	this->engine  = new Squirrel(APIName);
@@ -158,7 +165,7 @@ void ScriptInstance::Died()
 	this->is_dead = true;
 	this->in_shutdown = true;
 
-	this->last_allocated_memory = this->GetAllocatedMemory(); // Update cache
+	this->last_memory_stats = this->GetMemoryStats(); // Update cache
 
 	if (this->instance != nullptr) this->engine->ReleaseObject(this->instance);
 	delete this->instance;
@@ -177,6 +184,15 @@ void ScriptInstance::GameLoop()
 		this->Died();
 		return;
 	}
+
+	/* Sample the allocation rate about once a day. */
+	if (_tick_counter - this->allocation_sample_tick >= DAY_TICKS) {
+		uint64 allocations = this->engine->GetMemoryStats().allocations;
+		this->allocations_per_day = (allocations - this->allocation_sample) * DAY_TICKS / (_tick_counter - this->allocation_sample_tick);
+		this->allocation_sample = allocations;
+		this->allocation_sample_tick = _tick_counter;
+	}
+
 	if (this->is_paused) return;
 	this->controller->ticks++;
 
@@ -184,6 +200,9 @@ void ScriptInstance::GameLoop()
 	if (this->suspend   < 0)  return;          // Multiplayer suspend, wait for Continue().
 	if (--this->suspend > 0)  return;          // Singleplayer suspend, decrease to 0.
 
+	/* Once the script runs its save data may change, unless it promised to tell us. */
+	if (!this->cache_save_data) this->save_data_valid = false;
+
 	_current_company = ScriptObject::GetCompany();
 
 	/* If there is a callback to call, call that first */
@@ -350,7 +369,7 @@ static const SaveLoad _script_byte[] = {
 	SLEG_VAR("type", _script_sl_byte, SLE_UINT8),
 };
 
-/* static */ bool ScriptInstance::SaveObject(HSQUIRRELVM vm, SQInteger index, int max_depth, bool test)
+/* static */ bool ScriptInstance::SaveObject(HSQUIRRELVM vm, SQInteger index, int max_depth, std::vector<byte> *data)
 {
 	if (max_depth == 0) {
 		ScriptLog::Error("Savedata can only be nested to 25 deep. No data saved."); // SQUIRREL_MAX_DEPTH = 25
@@ -359,24 +378,18 @@ static const SaveLoad _script_byte[] = {
 
 	switch (sq_gettype(vm, index)) {
 		case OT_INTEGER: {
-			if (!test) {
-				_script_sl_byte = SQSL_INT;
-				SlObject(nullptr, _script_byte);
-			}
+			if (data != nullptr) data->push_back(SQSL_INT);
 			SQInteger res;
 			sq_getinteger(vm, index, &res);
-			if (!test) {
-				int64 value = (int64)res;
-				SlCopy(&value, 1, SLE_INT64);
+			if (data != nullptr) {
+				/* Stored big endian, like the savegame does. */
+				for (int shift = 56; shift >= 0; shift -= 8) data->push_back(GB((uint64)res, shift, 8));
 			}
 			return true;
 		}
 
 		case OT_STRING: {
-			if (!test) {
-				_script_sl_byte = SQSL_STRING;
-				SlObject(nullptr, _script_byte);
-			}
+			if (data != nullptr) data->push_back(SQSL_STRING);
 			const SQChar *buf;
 			sq_getstring(vm, index, &buf);
 			size_t len = strlen(buf) + 1;
@@ -384,23 +397,19 @@ static const SaveLoad _script_byte[] = {
 				ScriptLog::Error("Maximum string length is 254 chars. No data saved.");
 				return false;
 			}
-			if (!test) {
-				_script_sl_byte = (byte)len;
-				SlObject(nullptr, _script_byte);
-				SlCopy(const_cast<char *>(buf), len, SLE_CHAR);
+			if (data != nullptr) {
+				data->push_back((byte)len);
+				data->insert(data->end(), buf, buf + len);
 			}
 			return true;
 		}
 
 		case OT_ARRAY: {
-			if (!test) {
-				_script_sl_byte = SQSL_ARRAY;
-				SlObject(nullptr, _script_byte);
-			}
+			if (data != nullptr) data->push_back(SQSL_ARRAY);
 			sq_pushnull(vm);
 			while (SQ_SUCCEEDED(sq_next(vm, index - 1))) {
 				/* Store the value */
-				bool res = SaveObject(vm, -1, max_depth - 1, test);
+				bool res = SaveObject(vm, -1, max_depth - 1, data);
 				sq_pop(vm, 2);
 				if (!res) {
 					sq_pop(vm, 1);
@@ -408,22 +417,16 @@ static const SaveLoad _script_byte[] = {
 				}
 			}
 			sq_pop(vm, 1);
-			if (!test) {
-				_script_sl_byte = SQSL_ARRAY_TABLE_END;
-				SlObject(nullptr, _script_byte);
-			}
+			if (data != nullptr) data->push_back(SQSL_ARRAY_TABLE_END);
 			return true;
 		}
 
 		case OT_TABLE: {
-			if (!test) {
-				_script_sl_byte = SQSL_TABLE;
-				SlObject(nullptr, _script_byte);
-			}
+			if (data != nullptr) data->push_back(SQSL_TABLE);
 			sq_pushnull(vm);
 			while (SQ_SUCCEEDED(sq_next(vm, index - 1))) {
 				/* Store the key + value */
-				bool res = SaveObject(vm, -2, max_depth - 1, test) && SaveObject(vm, -1, max_depth - 1, test);
+				bool res = SaveObject(vm, -2, max_depth - 1, data) && SaveObject(vm, -1, max_depth - 1, data);
 				sq_pop(vm, 2);
 				if (!res) {
 					sq_pop(vm, 1);
@@ -431,32 +434,20 @@ static const SaveLoad _script_byte[] = {
 				}
 			}
 			sq_pop(vm, 1);
-			if (!test) {
-				_script_sl_byte = SQSL_ARRAY_TABLE_END;
-				SlObject(nullptr, _script_byte);
-			}
+			if (data != nullptr) data->push_back(SQSL_ARRAY_TABLE_END);
 			return true;
 		}
 
 		case OT_BOOL: {
-			if (!test) {
-				_script_sl_byte = SQSL_BOOL;
-				SlObject(nullptr, _script_byte);
-			}
+			if (data != nullptr) data->push_back(SQSL_BOOL);
 			SQBool res;
 			sq_getbool(vm, index, &res);
-			if (!test) {
-				_script_sl_byte = res ? 1 : 0;
-				SlObject(nullptr, _script_byte);
-			}
+			if (data != nullptr) data->push_back(res ? 1 : 0);
 			return true;
 		}
 
 		case OT_NULL: {
-			if (!test) {
-				_script_sl_byte = SQSL_NULL;
-				SlObject(nullptr, _script_byte);
-			}
+			if (data != nullptr) data->push_back(SQSL_NULL);
 			return true;
 		}
 
@@ -482,12 +473,16 @@ void ScriptInstance::Save()
 		return;
 	}
 
+	/* The script did not run since the data was made, or told us it did not change. */
+	if (this->save_data_valid) {
+		SlCopy(this->save_data.data(), this->save_data.size(), SLE_UINT8);
+		return;
+	}
+
 	HSQUIRRELVM vm = this->engine->GetVM();
 	if (this->is_save_data_on_stack) {
-		_script_sl_byte = 1;
-		SlObject(nullptr, _script_byte);
 		/* Save the data that was just loaded. */
-		SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, false);
+		this->StoreSaveData(vm);
 	} else if (!this->is_started) {
 		SaveEmpty();
 		return;
@@ -526,20 +521,35 @@ void ScriptInstance::Save()
 			return;
 		}
 		sq_pushobject(vm, savedata);
-		if (SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, true)) {
-			_script_sl_byte = 1;
-			SlObject(nullptr, _script_byte);
-			SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, false);
-			this->is_save_data_on_stack = true;
-		} else {
+		bool valid = SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, nullptr);
+		if (valid) this->StoreSaveData(vm);
+		sq_poptop(vm);
+		if (!valid) {
 			SaveEmpty();
 			this->engine->CrashOccurred();
+			return;
 		}
 	} else {
 		ScriptLog::Warning("Save function is not implemented");
-		_script_sl_byte = 0;
-		SlObject(nullptr, _script_byte);
+		this->save_data.assign(1, 0);
+		this->save_data_valid = true;
 	}
+
+	SlCopy(this->save_data.data(), this->save_data.size(), SLE_UINT8);
+}
+
+void ScriptInstance::StoreSaveData(HSQUIRRELVM vm)
+{
+	this->save_data.clear();
+	this->save_data.push_back(1);
+	SaveObject(vm, -1, SQUIRREL_MAX_DEPTH, &this->save_data);
+	this->save_data_valid = true;
+}
+
+void ScriptInstance::SetSaveDataCaching(bool enable)
+{
+	this->cache_save_data = enable;
+	if (!enable) this->save_data_valid = false;
 }
 
 void ScriptInstance::Pause()
@@ -744,6 +754,11 @@ SQInteger ScriptInstance::GetOpsTillSuspend()
 	return this->engine->GetOpsTillSuspend();
 }
 
+void ScriptInstance::DecreaseOps(int amount)
+{
+	Squirrel::DecreaseOps(this->engine->GetVM(), amount);
+}
+
 bool ScriptInstance::DoCommandCallback(const CommandCost &result, const CommandDataBuffer &data, CommandDataBuffer result_data, Commands cmd)
 {
 	ScriptObject::ActiveInstance active(this);
@@ -777,10 +792,16 @@ void ScriptInstance::InsertEvent(class ScriptEvent *event)
 
 size_t ScriptInstance::GetAllocatedMemory() const
 {
-	if (this->engine == nullptr) return this->last_allocated_memory;
+	if (this->engine == nullptr) return this->last_memory_stats.live_bytes;
 	return this->engine->GetAllocatedMemory();
 }
 
+ScriptMemoryStats ScriptInstance::GetMemoryStats() const
+{
+	if (this->engine == nullptr) return this->last_memory_stats;
+	return this->engine->GetMemoryStats();
+}
+
 void ScriptInstance::ReleaseSQObject(HSQOBJECT *obj)
 {
 	if (!this->in_shutdown) this->engine->ReleaseObject(obj);
@@ -12,8 +12,10 @@
 
 #include <variant>
 #include <list>
+#include <vector>
 #include <squirrel.h>
 #include "script_suspend.hpp"
+#include "squirrel.hpp"
 
 #include "../command_type.h"
 #include "../company_type.h"
@@ -162,6 +164,18 @@ public:
 	 */
 	static void SaveEmpty();
 
+	/**
+	 * Set whether the data of the script Save function is kept between saves
+	 *  until the script tells it has changed, instead of until the script runs.
+	 * @param enable True to keep the data until InvalidateSaveData is called.
+	 */
+	void SetSaveDataCaching(bool enable);
+
+	/**
+	 * Let the next save call the script Save function again.
+	 */
+	inline void InvalidateSaveData() { this->save_data_valid = false; }
+
 	/**
 	 * Load data from a savegame.
 	 * @param version The version of the script when saving, or -1 if this was
@@ -208,6 +222,13 @@ public:
 	 */
 	SQInteger GetOpsTillSuspend();
 
+	/**
+	 * Charge the script for work done natively on its behalf.
+	 * This function is safe to call from within a function called by the script.
+	 * @param amount The number of operations to subtract.
+	 */
+	void DecreaseOps(int amount);
+
 	/**
 	 * DoCommand callback function for all commands executed by scripts.
 	 * @param result The result of the command.
@@ -234,6 +255,17 @@ public:
 
 	size_t GetAllocatedMemory() const;
 
+	/**
+	 * Get statistics about the memory used by this script.
+	 * @return The statistics, or the last known ones when the script has died.
+	 */
+	ScriptMemoryStats GetMemoryStats() const;
+
+	/**
+	 * Get the number of memory allocations the script made during about the last day.
+	 */
+	inline uint64 GetAllocationsPerDay() const { return this->allocations_per_day; }
+
 	/**
 	 * Indicate whether this instance is currently being destroyed.
 	 */
@@ -285,11 +317,17 @@ private:
 	bool is_started;                      ///< Is the scripts constructor executed?
 	bool is_dead;                         ///< True if the script has been stopped.
 	bool is_save_data_on_stack;           ///< Is the save data still on the squirrel stack?
+	std::vector<byte> save_data;          ///< Serialised result of the last call to the script Save function.
+	bool save_data_valid;                 ///< Whether #save_data can be saved instead of calling the script Save function.
+	bool cache_save_data;                 ///< Whether the script tells when its save data changes.
 	int suspend;                          ///< The amount of ticks to suspend this script before it's allowed to continue.
 	bool is_paused;                       ///< Is the script paused? (a paused script will not be executed until unpaused)
 	bool in_shutdown;                     ///< Is this instance currently being destructed?
 	Script_SuspendCallbackProc *callback; ///< Callback that should be called in the next tick the script runs.
-	size_t last_allocated_memory;         ///< Last known allocated memory value (for display for crashed scripts)
+	ScriptMemoryStats last_memory_stats;  ///< Last known memory statistics (for display for crashed scripts)
+	uint64 allocation_sample;             ///< Number of allocations at #allocation_sample_tick.
+	uint64 allocation_sample_tick;        ///< Tick at which the allocation rate was last sampled.
+	uint64 allocations_per_day;           ///< Number of allocations during the last sampled day.
 
 	/**
 	 * Call the script Load function if it exists and data was loaded
@@ -303,11 +341,18 @@ private:
 	 * @param index The index on the squirrel stack of the element to save.
 	 * @param max_depth The maximum depth recursive arrays / tables will be stored
 	 *   with before an error is returned.
-	 * @param test If true, don't really store the data but only check if it is
-	 *   valid.
+	 * @param data The buffer to append the data to, or nullptr to only check
+	 *   if the data is valid.
 	 * @return True if the saving was successful.
 	 */
-	static bool SaveObject(HSQUIRRELVM vm, SQInteger index, int max_depth, bool test);
+	static bool SaveObject(HSQUIRRELVM vm, SQInteger index, int max_depth, std::vector<byte> *data);
+
+	/**
+	 * Turn the object on top of the squirrel stack into the data to save.
+	 * @param vm The virtual machine to get the data from.
+	 * @pre The object is valid save data.
+	 */
+	void StoreSaveData(HSQUIRRELVM vm);
 
 	/**
 	 * Load all objects from a savegame.
@@ -76,6 +76,8 @@ void ScriptScanner::RescanDir()
 {
 	/* Forget about older scans */
 	this->Reset();
+	/* Files in tars have no modification time, so compiled files cannot be trusted after a rescan */
+	Squirrel::ClearCompileCache();
 
 	/* Scan for scripts */
 	this->Scan(this->GetFileName(), this->GetDirectory());
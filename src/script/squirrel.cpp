@@ -17,10 +17,14 @@
 #include <sqstdaux.h>
 #include <../squirrel/sqpcheader.h>
 #include <../squirrel/sqvm.h>
+#include <../squirrel/sqstring.h>
+#include <../squirrel/sqtable.h>
 #include "../core/alloc_func.hpp"
 
 #include <stdarg.h>
+#include <sys/stat.h>
 #include <map>
+#include <vector>
 
 /**
  * In the memory allocator for Squirrel we want to directly use malloc/realloc, so when the OS
@@ -39,6 +43,10 @@
 struct ScriptAllocator {
 	size_t allocated_size;   ///< Sum of allocated data size
 	size_t allocation_limit; ///< Maximum this allocator may use before allocations fail
+	size_t peak_size;        ///< Highest value #allocated_size has had
+	size_t pooled_size;      ///< Memory reserved for the pools of small objects
+	size_t pool_used_size;   ///< Part of #pooled_size that is handed out to objects
+	uint64 allocation_count; ///< Number of allocations made so far
 	/**
 	 * Whether the error has already been thrown, so to not throw secondary errors in
 	 * the handling of the allocation error. This as the handling of the error will
@@ -49,39 +57,68 @@ struct ScriptAllocator {
 
 	static const size_t SAFE_LIMIT = 0x8000000; ///< 128 MiB, a safe choice for almost any situation
 
+	static const size_t POOL_GRANULARITY = 16;        ///< Difference in size between two pools of small objects; also their alignment.
+	static const size_t POOL_MAX_SIZE = 256;          ///< Largest allocation that is served from the pools of small objects.
+	static const size_t POOL_COUNT = POOL_MAX_SIZE / POOL_GRANULARITY; ///< Number of pools of small objects.
+	static const size_t POOL_CHUNK_SIZE = 64 * 1024;  ///< Size of the chunks the pools of small objects are cut from.
+
+	/** A freed small object, linking to the next freed object of the same size. */
+	struct FreeBlock {
+		FreeBlock *next; ///< Next freed object of the same pool.
+	};
+
+	FreeBlock *free_blocks[POOL_COUNT]; ///< Freed small objects of each pool.
+	std::vector<void *> chunks;         ///< Chunks of memory the small objects are cut from.
+	byte *chunk_pos;                    ///< First unused byte of the most recent chunk.
+	byte *chunk_end;                    ///< End of the most recent chunk.
+
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 	std::map<void *, size_t> allocations;
 #endif
 
+	/**
+	 * Get the amount of memory this allocator holds on to: the allocated objects plus
+	 * the memory of the pools of small objects that is not handed out to objects.
+	 * @return The memory that counts towards the allocation limit.
+	 */
+	inline size_t GetReservedSize() const
+	{
+		return this->allocated_size + this->pooled_size - this->pool_used_size;
+	}
+
 	void CheckLimit() const
 	{
-		if (this->allocated_size > this->allocation_limit) throw Script_FatalError("Maximum memory allocation exceeded");
+		if (this->GetReservedSize() > this->allocation_limit) throw Script_FatalError("Maximum memory allocation exceeded");
 	}
 
 	/**
-	 * Catch all validation for the allocation; did it allocate too much memory according
-	 * to the allocation limit or did the allocation at the OS level maybe fail? In those
-	 * error situations a Script_FatalError is thrown, but once that has been done further
-	 * allocations are allowed to make it possible for Squirrel to throw the error and
-	 * clean everything up.
-	 * @param requested_size The requested size that was requested to be allocated.
-	 * @param p              The pointer to the allocated object, or null if allocation failed.
+	 * Validate that the allocation does not go over the allocation limit. Once the error
+	 * has been thrown further allocations are allowed to make it possible for Squirrel to
+	 * throw the error and clean everything up.
+	 * @param requested_size The requested size that is going to be allocated.
 	 */
-	void CheckAllocation(size_t requested_size, void *p)
+	void CheckAllocationLimit(size_t requested_size)
 	{
-		if (this->allocated_size + requested_size > this->allocation_limit && !this->error_thrown) {
+		if (this->GetReservedSize() + requested_size > this->allocation_limit && !this->error_thrown) {
 			/* Do not allow allocating more than the allocation limit, except when an error is
 			 * already as then the allocation is for throwing that error in Squirrel, the
 			 * associated stack trace information and while cleaning up the AI. */
 			this->error_thrown = true;
 			char buff[128];
 			seprintf(buff, lastof(buff), "Maximum memory allocation exceeded by " PRINTF_SIZE " bytes when allocating " PRINTF_SIZE " bytes",
-				this->allocated_size + requested_size - this->allocation_limit, requested_size);
-			/* Don't leak the rejected allocation. */
-			free(p);
+				this->GetReservedSize() + requested_size - this->allocation_limit, requested_size);
 			throw Script_FatalError(buff);
 		}
+	}
 
+	/**
+	 * Validate whether the allocation at the OS level failed, in which case a
+	 * Script_FatalError is thrown.
+	 * @param requested_size The requested size that was requested to be allocated.
+	 * @param p              The pointer to the allocated object, or null if allocation failed.
+	 */
+	void CheckAllocationResult(size_t requested_size, void *p)
+	{
 		if (p == nullptr) {
 			/* The OS did not have enough memory to allocate the object, regardless of the
 			 * limit imposed by OpenTTD on the amount of memory that may be allocated. */
@@ -99,13 +136,108 @@ struct ScriptAllocator {
 		}
 	}
 
+	/**
+	 * Get the pool small objects of the given size are allocated from.
+	 * @param size The size of the object; must not be larger than #POOL_MAX_SIZE.
+	 * @return Index of the pool.
+	 */
+	static inline size_t GetPool(size_t size)
+	{
+		return size == 0 ? 0 : (size - 1) / POOL_GRANULARITY;
+	}
+
+	/**
+	 * Get memory for an object, either from the pools of small objects or from the OS.
+	 * Squirrel tells the size of the object when freeing it, so that is all that
+	 * is needed to know where the memory came from.
+	 * @param size The size of the object.
+	 * @return The memory, or nullptr when the OS did not have enough memory.
+	 */
+	void *Allocate(size_t size)
+	{
+		if (size > POOL_MAX_SIZE) return malloc(size);
+
+		size_t pool = GetPool(size);
+		size_t block_size = (pool + 1) * POOL_GRANULARITY;
+		FreeBlock *block = this->free_blocks[pool];
+		if (block != nullptr) {
+			this->free_blocks[pool] = block->next;
+			this->pool_used_size += block_size;
+			return block;
+		}
+
+		if (this->chunk_end - this->chunk_pos < (ptrdiff_t)block_size) {
+			/* The remainder of the current chunk is too small; it is simply not used.
+			 * Freed objects stay in the pools, so a new chunk counts in full towards the limit. */
+			this->CheckAllocationLimit(POOL_CHUNK_SIZE);
+			byte *chunk = static_cast<byte *>(malloc(POOL_CHUNK_SIZE));
+			if (chunk == nullptr) return nullptr;
+			this->chunks.push_back(chunk);
+			this->pooled_size += POOL_CHUNK_SIZE;
+			this->chunk_pos = chunk;
+			this->chunk_end = chunk + POOL_CHUNK_SIZE;
+		}
+
+		void *p = this->chunk_pos;
+		this->chunk_pos += block_size;
+		this->pool_used_size += block_size;
+		return p;
+	}
+
+	/**
+	 * Give the memory of an object back to where it came from.
+	 * @param p    The memory of the object.
+	 * @param size The size of the object.
+	 */
+	void Release(void *p, size_t size)
+	{
+		if (size > POOL_MAX_SIZE) {
+			free(p);
+			return;
+		}
+
+		size_t pool = GetPool(size);
+		FreeBlock *block = static_cast<FreeBlock *>(p);
+		block->next = this->free_blocks[pool];
+		this->free_blocks[pool] = block;
+		this->pool_used_size -= (pool + 1) * POOL_GRANULARITY;
+	}
+
+	/**
+	 * Free all chunks of the pools of small objects at once.
+	 * @pre No object of the pools is in use anymore.
+	 */
+	void ReleasePools()
+	{
+		for (void *chunk : this->chunks) free(chunk);
+		this->chunks.clear();
+		this->pooled_size = 0;
+		this->pool_used_size = 0;
+		this->chunk_pos = nullptr;
+		this->chunk_end = nullptr;
+		std::fill(std::begin(this->free_blocks), std::end(this->free_blocks), nullptr);
+	}
+
+	/**
+	 * Account for a change in the amount of allocated memory.
+	 * @param new_size Amount of memory allocated now.
+	 */
+	inline void SetAllocatedSize(size_t new_size)
+	{
+		this->allocated_size = new_size;
+		this->peak_size = std::max(this->peak_size, new_size);
+		this->allocation_count++;
+	}
+
 	void *Malloc(SQUnsignedInteger size)
 	{
-		void *p = malloc(size);
+		this->CheckAllocationLimit(size);
+
+		void *p = this->Allocate(size);
 
-		this->CheckAllocation(size, p);
+		this->CheckAllocationResult(size, p);
 
-		this->allocated_size += size;
+		this->SetAllocatedSize(this->allocated_size + size);
 
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 		assert(p != nullptr);
@@ -126,6 +258,17 @@ struct ScriptAllocator {
 			return nullptr;
 		}
 
+		/* Small objects that stay in the same pool do not have to move. */
+		if (oldsize <= POOL_MAX_SIZE && size <= POOL_MAX_SIZE && GetPool(oldsize) == GetPool(size)) {
+			this->CheckAllocationLimit(size - oldsize);
+#ifdef SCRIPT_DEBUG_ALLOCATIONS
+			assert(this->allocations[p] == oldsize);
+			this->allocations[p] = size;
+#endif
+			this->SetAllocatedSize(this->allocated_size - oldsize + size);
+			return p;
+		}
+
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 		assert(this->allocations[p] == oldsize);
 		this->allocations.erase(p);
@@ -134,16 +277,17 @@ struct ScriptAllocator {
 		 * If memory exception is thrown, the old pointer is expected
 		 * to be valid for engine cleanup.
 		 */
-		void *new_p = malloc(size);
+		this->CheckAllocationLimit(size - oldsize);
+
+		void *new_p = this->Allocate(size);
 
-		this->CheckAllocation(size - oldsize, new_p);
+		this->CheckAllocationResult(size - oldsize, new_p);
 
 		/* Memory limit test passed, we can copy data and free old pointer. */
 		memcpy(new_p, p, std::min(oldsize, size));
-		free(p);
+		this->Release(p, oldsize);
 
-		this->allocated_size -= oldsize;
-		this->allocated_size += size;
+		this->SetAllocatedSize(this->allocated_size - oldsize + size);
 
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 		assert(new_p != nullptr);
@@ -157,7 +301,7 @@ struct ScriptAllocator {
 	void Free(void *p, SQUnsignedInteger size)
 	{
 		if (p == nullptr) return;
-		free(p);
+		this->Release(p, size);
 		this->allocated_size -= size;
 
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
@@ -171,7 +315,14 @@ struct ScriptAllocator {
 		this->allocated_size = 0;
 		this->allocation_limit = static_cast<size_t>(_settings_game.script.script_max_memory_megabytes) << 20;
 		if (this->allocation_limit == 0) this->allocation_limit = SAFE_LIMIT; // in case the setting is somehow zero
+		this->peak_size = 0;
+		this->pooled_size = 0;
+		this->pool_used_size = 0;
+		this->allocation_count = 0;
 		this->error_thrown = false;
+		this->chunk_pos = nullptr;
+		this->chunk_end = nullptr;
+		std::fill(std::begin(this->free_blocks), std::end(this->free_blocks), nullptr);
 	}
 
 	~ScriptAllocator()
@@ -179,6 +330,7 @@ struct ScriptAllocator {
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 		assert(this->allocations.size() == 0);
 #endif
+		this->ReleasePools();
 	}
 };
 
@@ -202,7 +354,18 @@ void sq_vm_free(void *p, SQUnsignedInteger size) { _squirrel_allocator->Free(p,
 size_t Squirrel::GetAllocatedMemory() const noexcept
 {
 	assert(this->allocator != nullptr);
-	return this->allocator->allocated_size;
+	return this->allocator->GetReservedSize();
+}
+
+ScriptMemoryStats Squirrel::GetMemoryStats() const noexcept
+{
+	assert(this->allocator != nullptr);
+	ScriptMemoryStats stats;
+	stats.live_bytes = this->allocator->allocated_size;
+	stats.peak_bytes = this->allocator->peak_size;
+	stats.pooled_bytes = this->allocator->pooled_size;
+	stats.allocations = this->allocator->allocation_count;
+	return stats;
 }
 
 
@@ -644,6 +807,262 @@ static SQInteger _io_file_read(SQUserPointer file, SQUserPointer buf, SQInteger
 	return ret;
 }
 
+/** A scalar value of a constant declared by a compiled script file. */
+struct ScriptCachedValue {
+	SQObjectType object_type; ///< Type of the value; OT_INTEGER, OT_FLOAT or OT_STRING.
+	SQInteger integer;        ///< The value, when it is an integer.
+	SQFloat real;             ///< The value, when it is a float.
+	std::string string;       ///< The value, when it is a string.
+};
+
+/** A constant or enum declared by a compiled script file. */
+struct ScriptCachedConstant {
+	std::string name;                                               ///< Name of the constant or enum.
+	bool is_enum;                                                   ///< Whether this is an enum instead of a constant.
+	ScriptCachedValue value;                                        ///< Value of the constant.
+	std::vector<std::pair<std::string, ScriptCachedValue>> members; ///< Members of the enum.
+};
+
+/** A compiled script file, so the next VM loading the same file does not need to compile it again. */
+struct ScriptCompiledFile {
+	std::string api_name;                        ///< API the file was compiled for.
+	time_t mtime;                                ///< Modification time of the file when it was compiled.
+	size_t size;                                 ///< Size of the file when it was compiled.
+	uint64 consts_hash;                          ///< Hash of the constants known to the compiler; these are folded into the bytecode.
+	std::vector<byte> bytecode;                  ///< The compiled closure, as written by sq_writeclosure.
+	std::vector<ScriptCachedConstant> constants; ///< Constants and enums the compiler added to the constants table.
+};
+
+/** Compiled script files, by filename. */
+static std::map<std::string, ScriptCompiledFile> _script_compile_cache;
+
+/* static */ void Squirrel::ClearCompileCache()
+{
+	_script_compile_cache.clear();
+}
+
+/**
+ * Get the modification time of a script file.
+ * @param filename The file to get the modification time of.
+ * @return The modification time, or 0 when it is not known, like for files in tars.
+ */
+static time_t GetScriptModificationTime(const char *filename)
+{
+#ifdef _WIN32
+	struct _stat64 sb;
+	if (_wstat64(OTTD2FS(filename).c_str(), &sb) == 0) return (time_t)sb.st_mtime;
+#else
+	struct stat sb;
+	if (stat(OTTD2FS(filename).c_str(), &sb) == 0) return sb.st_mtime;
+#endif
+	return 0;
+}
+
+/**
+ * Update a FNV-1a hash with some data.
+ * @param hash The hash so far.
+ * @param data The data to add.
+ * @param length The length of the data.
+ * @return The new hash.
+ */
+static uint64 HashBytes(uint64 hash, const void *data, size_t length)
+{
+	const byte *bytes = (const byte *)data;
+	for (size_t i = 0; i < length; i++) {
+		hash ^= bytes[i];
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+/**
+ * Get a hash of the value of a constant.
+ * @param o The value.
+ * @param nested Whether the value is part of a table, in which case tables are not hashed any deeper.
+ * @return The hash.
+ */
+static uint64 HashConstValue(const SQObjectPtr &o, bool nested)
+{
+	uint64 hash = HashBytes(0xCBF29CE484222325ULL, &o._type, sizeof(o._type));
+	switch (o._type) {
+		case OT_INTEGER: return HashBytes(hash, &_integer(o), sizeof(SQInteger));
+		case OT_FLOAT:   return HashBytes(hash, &_float(o), sizeof(SQFloat));
+		case OT_STRING:  return HashBytes(hash, _stringval(o), _string(o)->_len);
+
+		case OT_TABLE: {
+			if (nested) return hash;
+			/* The order of the slots depends on the history of the table, so combine them independent of the order. */
+			uint64 slots = 0;
+			SQObjectPtr key, value;
+			for (SQInteger i = 0; (i = _table(o)->Next(false, SQObjectPtr(i), key, value)) != -1;) {
+				uint64 value_hash = HashConstValue(value, true);
+				slots += HashBytes(HashConstValue(key, true), &value_hash, sizeof(value_hash));
+			}
+			return HashBytes(hash, &slots, sizeof(slots));
+		}
+
+		default: return hash;
+	}
+}
+
+/**
+ * Get a hash of every constant known to the compiler of a VM.
+ * @param vm The VM to get the constants of.
+ * @return The hash of every constant, by name.
+ */
+static std::map<std::string, uint64> GetConstHashes(HSQUIRRELVM vm)
+{
+	std::map<std::string, uint64> hashes;
+	const SQObjectPtr &consts = _ss(vm)->_consts;
+	if (consts._type != OT_TABLE) return hashes;
+
+	SQObjectPtr key, value;
+	for (SQInteger i = 0; (i = _table(consts)->Next(false, SQObjectPtr(i), key, value)) != -1;) {
+		if (key._type != OT_STRING) continue;
+		hashes[std::string(_stringval(key), _string(key)->_len)] = HashConstValue(value, false);
+	}
+	return hashes;
+}
+
+/**
+ * Combine the hashes of the constants in a single hash.
+ * @param hashes The hash of every constant, by name.
+ * @return The combined hash.
+ */
+static uint64 CombineConstHashes(const std::map<std::string, uint64> &hashes)
+{
+	uint64 hash = 0xCBF29CE484222325ULL;
+	for (const auto &it : hashes) {
+		hash = HashBytes(hash, it.first.data(), it.first.size());
+		hash = HashBytes(hash, &it.second, sizeof(it.second));
+	}
+	return hash;
+}
+
+/**
+ * Store a scalar value for the compile cache.
+ * @param o The value to store.
+ * @param[out] value The stored value.
+ * @return False if the value cannot be stored.
+ */
+static bool StoreCachedValue(const SQObjectPtr &o, ScriptCachedValue &value)
+{
+	value.object_type = o._type;
+	switch (o._type) {
+		case OT_INTEGER: value.integer = _integer(o); return true;
+		case OT_FLOAT:   value.real = _float(o); return true;
+		case OT_STRING:  value.string.assign(_stringval(o), _string(o)->_len); return true;
+		default: return false;
+	}
+}
+
+/**
+ * Create the object of a value from the compile cache.
+ * @param vm The VM to create the object in.
+ * @param value The stored value.
+ * @return The object.
+ */
+static SQObjectPtr LoadCachedValue(HSQUIRRELVM vm, const ScriptCachedValue &value)
+{
+	switch (value.object_type) {
+		case OT_INTEGER: return SQObjectPtr(value.integer);
+		case OT_FLOAT:   return SQObjectPtr(value.real);
+		default:         return SQObjectPtr(SQString::Create(_ss(vm), value.string.data(), value.string.size()));
+	}
+}
+
+static SQInteger _io_bytecode_write(SQUserPointer bytecode, SQUserPointer buf, SQInteger size)
+{
+	std::vector<byte> *data = (std::vector<byte> *)bytecode;
+	data->insert(data->end(), (const byte *)buf, (const byte *)buf + size);
+	return size;
+}
+
+/** Reader of the bytecode in the compile cache. */
+struct SQBytecodeReader {
+	const std::vector<byte> &bytecode; ///< The bytecode to read.
+	size_t pos;                        ///< Position of the next byte to read.
+};
+
+static SQInteger _io_bytecode_read(SQUserPointer reader, SQUserPointer buf, SQInteger size)
+{
+	SQBytecodeReader *r = (SQBytecodeReader *)reader;
+	size_t count = std::min<size_t>(size, r->bytecode.size() - r->pos);
+	if (count == 0) return -1;
+	memcpy(buf, r->bytecode.data() + r->pos, count);
+	r->pos += count;
+	return count;
+}
+
+/**
+ * Store the closure a file was just compiled to, and the constants the
+ *  compiler added while compiling, in a compiled file.
+ * @param vm The VM with the compiled closure on top of the stack.
+ * @param consts_before The hash of every constant known before compiling.
+ * @param[out] compiled The compiled file to fill.
+ * @return False if the file cannot be cached.
+ */
+static bool StoreCompiledFile(HSQUIRRELVM vm, const std::map<std::string, uint64> &consts_before, ScriptCompiledFile &compiled)
+{
+	if (SQ_FAILED(sq_writeclosure(vm, _io_bytecode_write, &compiled.bytecode))) {
+		sq_reseterror(vm);
+		return false;
+	}
+
+	const SQObjectPtr &consts = _ss(vm)->_consts;
+	if (consts._type != OT_TABLE) return false;
+
+	SQObjectPtr key, value;
+	for (SQInteger i = 0; (i = _table(consts)->Next(false, SQObjectPtr(i), key, value)) != -1;) {
+		if (key._type != OT_STRING) continue;
+		std::string name(_stringval(key), _string(key)->_len);
+		auto it = consts_before.find(name);
+		if (it != consts_before.end() && it->second == HashConstValue(value, false)) continue;
+
+		ScriptCachedConstant &constant = compiled.constants.emplace_back();
+		constant.name = name;
+		constant.is_enum = value._type == OT_TABLE;
+		if (!constant.is_enum) {
+			if (!StoreCachedValue(value, constant.value)) return false;
+			continue;
+		}
+
+		SQObjectPtr member_key, member_value;
+		for (SQInteger j = 0; (j = _table(value)->Next(false, SQObjectPtr(j), member_key, member_value)) != -1;) {
+			auto &member = constant.members.emplace_back();
+			if (member_key._type != OT_STRING || !StoreCachedValue(member_value, member.second)) return false;
+			member.first.assign(_stringval(member_key), _string(member_key)->_len);
+		}
+	}
+	return true;
+}
+
+/**
+ * Load a compiled file: add the constants it declares and push its closure.
+ * @param vm The VM to load the file in.
+ * @param compiled The compiled file.
+ * @return Whether the closure could be read.
+ */
+static SQRESULT LoadCompiledFile(HSQUIRRELVM vm, const ScriptCompiledFile &compiled)
+{
+	SQTable *consts = _table(_ss(vm)->_consts);
+	for (const ScriptCachedConstant &constant : compiled.constants) {
+		SQObjectPtr value;
+		if (constant.is_enum) {
+			value = SQTable::Create(_ss(vm), 0);
+			for (const auto &member : constant.members) {
+				_table(value)->NewSlot(SQObjectPtr(SQString::Create(_ss(vm), member.first.data(), member.first.size())), LoadCachedValue(vm, member.second));
+			}
+		} else {
+			value = LoadCachedValue(vm, constant.value);
+		}
+		consts->NewSlot(SQObjectPtr(SQString::Create(_ss(vm), constant.name.data(), constant.name.size())), value);
+	}
+
+	SQBytecodeReader reader{compiled.bytecode, 0};
+	return sq_readclosure(vm, _io_bytecode_read, &reader);
+}
+
 SQRESULT Squirrel::LoadFile(HSQUIRRELVM vm, const char *filename, SQBool printerror)
 {
 	ScriptAllocatorScope alloc_scope(this);
@@ -663,6 +1082,27 @@ SQRESULT Squirrel::LoadFile(HSQUIRRELVM vm, const char *filename, SQBool printer
 	if (file == nullptr) {
 		return sq_throwerror(vm, "cannot open the file");
 	}
+
+	/* Compiling is by far the slowest part of loading a script, and the same
+	 * files get loaded by every instance of the same script. So reuse the
+	 * bytecode as long as the file and the constants it may fold are unchanged. */
+	time_t mtime = GetScriptModificationTime(filename);
+	size_t file_size = size;
+	std::map<std::string, uint64> consts_before = GetConstHashes(vm);
+	uint64 consts_hash = CombineConstHashes(consts_before);
+
+	auto cached = _script_compile_cache.find(filename);
+	if (cached != _script_compile_cache.end() && _ss(vm)->_consts._type == OT_TABLE) {
+		const ScriptCompiledFile &compiled = cached->second;
+		if (compiled.api_name == this->GetAPIName() && compiled.mtime == mtime && compiled.size == file_size && compiled.consts_hash == consts_hash) {
+			FioFCloseFile(file);
+			Debug(script, 6, "[squirrel] Using cached bytecode for '{}'", filename);
+			if (SQ_SUCCEEDED(LoadCompiledFile(vm, compiled))) return SQ_OK;
+			_script_compile_cache.erase(cached);
+			return sq_throwerror(vm, "Couldn't read bytecode");
+		}
+	}
+
 	unsigned short bom = 0;
 	if (size >= 2) {
 		[[maybe_unused]] size_t sr = fread(&bom, 1, sizeof(bom), file);
@@ -724,6 +1164,13 @@ SQRESULT Squirrel::LoadFile(HSQUIRRELVM vm, const char *filename, SQBool printer
 	SQFile f(file, size);
 	if (SQ_SUCCEEDED(sq_compile(vm, func, &f, filename, printerror))) {
 		FioFCloseFile(file);
+
+		ScriptCompiledFile compiled{this->GetAPIName(), mtime, file_size, consts_hash, {}, {}};
+		if (StoreCompiledFile(vm, consts_before, compiled)) {
+			_script_compile_cache[filename] = std::move(compiled);
+		} else {
+			_script_compile_cache.erase(filename);
+		}
 		return SQ_OK;
 	}
 	FioFCloseFile(file);
@@ -780,6 +1227,9 @@ void Squirrel::Uninitialize()
 
 	assert(this->allocator->allocated_size == 0);
 
+	/* Nothing of the VM is left, so all small objects can go at once. */
+	this->allocator->ReleasePools();
+
 	/* Reset memory allocation errors. */
 	this->allocator->error_thrown = false;
 }
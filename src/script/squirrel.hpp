@@ -20,6 +20,14 @@ enum ScriptType {
 
 struct ScriptAllocator;
 
+/** Statistics about the memory used by a script. */
+struct ScriptMemoryStats {
+	size_t live_bytes;   ///< Memory currently allocated by the script.
+	size_t peak_bytes;   ///< Highest amount of memory the script has had allocated.
+	size_t pooled_bytes; ///< Memory reserved for the pools of small objects of the script.
+	uint64 allocations;  ///< Number of allocations the script made.
+};
+
 class Squirrel {
 	friend class ScriptAllocatorScope;
 
@@ -92,6 +100,12 @@ public:
 	 */
 	SQRESULT LoadFile(HSQUIRRELVM vm, const char *filename, SQBool printerror);
 
+	/**
+	 * Forget about all compiled script files, so they get compiled again the
+	 *  next time they are loaded.
+	 */
+	static void ClearCompileCache();
+
 	/**
 	 * Adds a function to the stack. Depending on the current state this means
 	 *  either a method or a global function.
@@ -280,6 +294,11 @@ public:
 	 * Get number of bytes allocated by this VM.
 	 */
 	size_t GetAllocatedMemory() const noexcept;
+
+	/**
+	 * Get statistics about the memory allocations of this VM.
+	 */
+	ScriptMemoryStats GetMemoryStats() const noexcept;
 };
 
 
@@ -134,8 +134,10 @@ struct GUISettings {
 	ZoomLevel zoom_min;                      ///< minimum zoom out level
 	ZoomLevel zoom_max;                      ///< maximum zoom out level
 	ZoomLevel sprite_zoom_min;               ///< maximum zoom level at which higher-resolution alternative sprites will be used (if available) instead of scaling a lower resolution sprite
+	uint8  viewport_draw_bands;              ///< number of horizontal bands a viewport is drawn in; the sprites of all but the first band are sorted on worker threads (0 or 1 = draw in one go)
 	byte   autosave;                         ///< how often should we do autosaves?
 	bool   threaded_saves;                   ///< should we do threaded saves?
+	bool   threaded_screenshots;             ///< should we encode large screenshots on a separate thread?
 	bool   keep_all_autosave;                ///< name the autosave in a different way
 	bool   autosave_on_exit;                 ///< save an autosave when you quit the game, but do not ask "Do you really want to quit?"
 	bool   autosave_on_network_disconnect;   ///< save an autosave when you get disconnected from a network game with an error?
@@ -372,6 +374,7 @@ struct AISettings {
 	bool   ai_disable_veh_roadveh;           ///< disable types for AI
 	bool   ai_disable_veh_aircraft;          ///< disable types for AI
 	bool   ai_disable_veh_ship;              ///< disable types for AI
+	uint16 ai_max_per_tick;                  ///< maximum number of AIs that run in a single tick, 0 for all
 };
 
 /** Settings related to scripts. */
@@ -379,6 +382,7 @@ struct ScriptSettings {
 	uint8  settings_profile;                 ///< difficulty profile to set initial settings of scripts, esp. random AIs
 	uint32 script_max_opcode_till_suspend;   ///< max opcode calls till scripts will suspend
 	uint32 script_max_memory_megabytes;      ///< limit on memory a single script instance may have allocated
+	uint32 script_max_events;                ///< maximum number of events waiting for a single script instance, 0 for no limit
 };
 
 /** Settings related to the new pathfinder. */
@@ -589,6 +589,55 @@ uint32 GetSmallMapOwnerPixels(TileIndex tile, TileType t, IncludeHeightmap inclu
 	return MKCOLOUR_XXXX(_legend_land_owners[_company_to_list_pos[o]].colour);
 }
 
+/**
+ * Compute the colours of one row of tiles of a minimap with one pixel per tile.
+ * Unlike the smallmap window this only looks at the tile itself and the legends,
+ * so it works without any window or video driver, e.g. on a dedicated server.
+ * @param type Information to show.
+ * @param y    Row of tiles to compute.
+ * @param[out] buf Palette indices of the MapSizeX() tiles of the row, starting at the highest x coordinate.
+ */
+void GetMinimapRowColours(MinimapType type, uint y, uint8 *buf)
+{
+	const SmallMapColourScheme *cs = &_heightmap_schemes[_settings_client.gui.smallmap_land_colour];
+
+	TileIndex tile = TileXY(MapMaxX(), y);
+	for (uint i = 0; i < MapSizeX(); i++, tile--) {
+		TileType t = GetTileType(tile);
+		if (t == MP_TUNNELBRIDGE) {
+			switch (GetTunnelBridgeTransportType(tile)) {
+				case TRANSPORT_RAIL: t = MP_RAILWAY; break;
+				case TRANSPORT_ROAD: t = MP_ROAD;    break;
+				default:             t = MP_WATER;   break;
+			}
+		}
+
+		uint32 colour;
+		switch (type) {
+			case MMT_OWNER:
+				colour = GetSmallMapOwnerPixels(tile, t, IncludeHeightmap::Never);
+				break;
+
+			case MMT_INDUSTRY:
+				colour = (t == MP_INDUSTRY) ? MKCOLOUR_XXXX(GetIndustrySpec(Industry::GetByTile(tile)->type)->map_colour) : ApplyMask(cs->default_colour, &_smallmap_vehicles_andor[t]);
+				break;
+
+			case MMT_ROUTES:
+				colour = GetSmallMapRoutesPixels(tile, t);
+				break;
+
+			case MMT_VEGETATION:
+				colour = GetSmallMapVegetationPixels(tile, t);
+				break;
+
+			default: NOT_REACHED();
+		}
+
+		/* The smallmap draws a tile as four pixels; the middle ones show what is on the tile. */
+		buf[i] = GB(colour, 8, 8);
+	}
+}
+
 /** Vehicle colours in #SMT_VEHICLES mode. Indexed by #VehicleType. */
 static const byte _vehicle_type_colours[6] = {
 	PC_RED, PC_YELLOW, PC_LIGHT_BLUE, PC_WHITE, PC_BLACK, PC_RED
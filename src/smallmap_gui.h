@@ -18,6 +18,7 @@
 #include "linkgraph/linkgraph_gui.h"
 #include "widgets/smallmap_widget.h"
 #include "guitimer_func.h"
+#include "screenshot.h"
 
 /* set up the cargos to be displayed in the smallmap's route legend */
 void BuildLinkStatsLegend();
@@ -35,6 +36,7 @@ enum class IncludeHeightmap {
 };
 
 uint32 GetSmallMapOwnerPixels(TileIndex tile, TileType t, IncludeHeightmap include_heightmap);
+void GetMinimapRowColours(MinimapType type, uint y, uint8 *buf);
 
 /** Structure for holding relevant data for legends in small map */
 struct LegendAndColour {
@@ -33,7 +33,7 @@ struct SpriteCache {
 	size_t file_pos;
 	SpriteFile *file;    ///< The file the sprite in this entry can be found in.
 	uint32 id;
-	int16 lru;
+	bool referenced;     ///< Whether the sprite has been used since the eviction clock last passed it.
 	SpriteType type;     ///< In some cases a single sprite is misused by two NewGRFs. Once as real sprite and once as recolour sprite. If the recolour sprite gets into the cache it might be drawn as real sprite which causes enormous trouble.
 	bool warned;         ///< True iff the user has been warned about incorrect use of this sprite
 	byte control_flags;  ///< Control flags, see SpriteCacheCtrlFlags
@@ -104,17 +104,19 @@ SpriteFile &OpenCachedSpriteFile(const std::string &filename, Subdirectory subdi
 	return *file;
 }
 
+/** Header in front of every block of memory handed out by the sprite cache. */
 struct MemBlock {
-	size_t size;
+	size_t size_class; ///< Size class of the block, see GetSpriteSizeClass().
 	byte data[];
 };
 
-static uint _sprite_lru_counter;
-static MemBlock *_spritecache_ptr;
-static uint _allocated_sprite_cache_size = 0;
-static int _compact_cache_counter;
+static size_t _sprite_cache_budget = 0;    ///< Maximum number of bytes the sprite cache may keep allocated.
+static size_t _sprite_cache_used = 0;      ///< Number of bytes in blocks that hold a sprite.
+static size_t _sprite_cache_spare = 0;     ///< Number of bytes in blocks waiting in a free list.
+static uint _sprite_clock_hand = 0;        ///< Next sprite cache entry to be considered for eviction.
+static std::vector<std::vector<MemBlock *>> _sprite_free_blocks; ///< Free blocks for reuse, per size class.
 
-static void CompactSpriteCache();
+static void DeleteEntryFromSpriteCache(uint item);
 static void *AllocSprite(size_t mem_req);
 
 /**
@@ -667,8 +669,9 @@ bool LoadNextSprite(int load_index, SpriteFile &file, uint file_sprite_id)
 	SpriteCache *sc = AllocateSpriteCache(load_index);
 	sc->file = &file;
 	sc->file_pos = file_pos;
+	if (sc->ptr != nullptr) DeleteEntryFromSpriteCache(load_index);
 	sc->ptr = data;
-	sc->lru = 0;
+	sc->referenced = false;
 	sc->id = file_sprite_id;
 	sc->type = type;
 	sc->warned = false;
@@ -692,188 +695,141 @@ void DupSprite(SpriteID old_spr, SpriteID new_spr)
 }
 
 /**
- * S_FREE_MASK is used to mask-out lower bits of MemBlock::size
- * If they are non-zero, the block is free.
- * S_FREE_MASK has to ensure MemBlock is correctly aligned -
- * it means 8B (S_FREE_MASK == 7) on 64bit systems!
+ * Get the size class for a block of memory.
+ * Up to 64 bytes the classes are 16 bytes apart, after that there are
+ * four classes between each power of two, so at most a fifth of a block is wasted.
+ * @param size Number of bytes needed, including the MemBlock header.
+ * @return The size class.
  */
-static const size_t S_FREE_MASK = sizeof(size_t) - 1;
-
-/* to make sure nobody adds things to MemBlock without checking S_FREE_MASK first */
-static_assert(sizeof(MemBlock) == sizeof(size_t));
-/* make sure it's a power of two */
-static_assert((sizeof(size_t) & (sizeof(size_t) - 1)) == 0);
-
-static inline MemBlock *NextBlock(MemBlock *block)
-{
-	return (MemBlock*)((byte*)block + (block->size & ~S_FREE_MASK));
-}
-
-static size_t GetSpriteCacheUsage()
+static inline uint GetSpriteSizeClass(size_t size)
 {
-	size_t tot_size = 0;
-	MemBlock *s;
-
-	for (s = _spritecache_ptr; s->size != 0; s = NextBlock(s)) {
-		if (!(s->size & S_FREE_MASK)) tot_size += s->size;
-	}
+	assert(size > 0);
+	if (size <= 64) return (uint)((size - 1) / 16);
 
-	return tot_size;
+	uint shift = FindLastBit(size - 1) - 2;
+	return 4 + (shift - 4) * 4 + (uint)((size - 1) >> shift) - 4;
 }
 
-
-void IncreaseSpriteLRU()
+/**
+ * Get the number of bytes of the blocks of a size class.
+ * @param size_class The size class.
+ * @return Size of the blocks, including the MemBlock header.
+ */
+static inline size_t GetSpriteSizeClassBytes(uint size_class)
 {
-	/* Increase all LRU values */
-	if (_sprite_lru_counter > 16384) {
-		SpriteID i;
-
-		Debug(sprite, 3, "Fixing lru {}, inuse={}", _sprite_lru_counter, GetSpriteCacheUsage());
-
-		for (i = 0; i != _spritecache_items; i++) {
-			SpriteCache *sc = GetSpriteCache(i);
-			if (sc->ptr != nullptr) {
-				if (sc->lru >= 0) {
-					sc->lru = -1;
-				} else if (sc->lru != -32768) {
-					sc->lru--;
-				}
-			}
-		}
-		_sprite_lru_counter = 0;
-	}
+	if (size_class < 4) return (size_class + 1) * 16;
 
-	/* Compact sprite cache every now and then. */
-	if (++_compact_cache_counter >= 740) {
-		CompactSpriteCache();
-		_compact_cache_counter = 0;
-	}
+	uint shift = (size_class - 4) / 4 + 4;
+	return (size_t)((size_class - 4) % 4 + 5) << shift;
 }
 
 /**
- * Called when holes in the sprite cache should be removed.
- * That is accomplished by moving the cached data.
+ * Get the header of a block of sprite memory.
+ * @param ptr The sprite data, as returned by AllocSprite().
+ * @return The header of the block.
  */
-static void CompactSpriteCache()
+static inline MemBlock *GetMemBlock(void *ptr)
 {
-	MemBlock *s;
-
-	Debug(sprite, 3, "Compacting sprite cache, inuse={}", GetSpriteCacheUsage());
-
-	for (s = _spritecache_ptr; s->size != 0;) {
-		if (s->size & S_FREE_MASK) {
-			MemBlock *next = NextBlock(s);
-			MemBlock temp;
-			SpriteID i;
-
-			/* Since free blocks are automatically coalesced, this should hold true. */
-			assert(!(next->size & S_FREE_MASK));
-
-			/* If the next block is the sentinel block, we can safely return */
-			if (next->size == 0) break;
-
-			/* Locate the sprite belonging to the next pointer. */
-			for (i = 0; GetSpriteCache(i)->ptr != next->data; i++) {
-				assert(i != _spritecache_items);
-			}
-
-			GetSpriteCache(i)->ptr = s->data; // Adjust sprite array entry
-			/* Swap this and the next block */
-			temp = *s;
-			memmove(s, next, next->size);
-			s = NextBlock(s);
-			*s = temp;
+	return (MemBlock *)((byte *)ptr - offsetof(MemBlock, data));
+}
 
-			/* Coalesce free blocks */
-			while (NextBlock(s)->size & S_FREE_MASK) {
-				s->size += NextBlock(s)->size & ~S_FREE_MASK;
-			}
-		} else {
-			s = NextBlock(s);
-		}
+/** Return all blocks in the free lists to the system. */
+static void ReleaseSpareSpriteBlocks()
+{
+	for (auto &blocks : _sprite_free_blocks) {
+		for (MemBlock *block : blocks) free(block);
+		blocks.clear();
 	}
+	_sprite_cache_spare = 0;
 }
 
 /**
  * Delete a single entry from the sprite cache.
+ * The memory of the entry is kept in the free list of its size class.
  * @param item Entry to delete.
  */
 static void DeleteEntryFromSpriteCache(uint item)
 {
-	/* Mark the block as free (the block must be in use) */
-	MemBlock *s = (MemBlock*)GetSpriteCache(item)->ptr - 1;
-	assert(!(s->size & S_FREE_MASK));
-	s->size |= S_FREE_MASK;
-	GetSpriteCache(item)->ptr = nullptr;
-
-	/* And coalesce adjacent free blocks */
-	for (s = _spritecache_ptr; s->size != 0; s = NextBlock(s)) {
-		if (s->size & S_FREE_MASK) {
-			while (NextBlock(s)->size & S_FREE_MASK) {
-				s->size += NextBlock(s)->size & ~S_FREE_MASK;
-			}
-		}
-	}
+	SpriteCache *sc = GetSpriteCache(item);
+	MemBlock *block = GetMemBlock(sc->ptr);
+	size_t bytes = GetSpriteSizeClassBytes((uint)block->size_class);
+
+	_sprite_free_blocks[block->size_class].push_back(block);
+	_sprite_cache_used -= bytes;
+	_sprite_cache_spare += bytes;
+	sc->ptr = nullptr;
 }
 
+/**
+ * Evict one sprite from the cache using the CLOCK algorithm.
+ * Sprites that were used since the clock hand last passed them get a second chance.
+ */
 static void DeleteEntryFromSpriteCache()
 {
-	uint best = UINT_MAX;
-	int cur_lru;
+	Debug(sprite, 3, "DeleteEntryFromSpriteCache, inuse={}", _sprite_cache_used);
 
-	Debug(sprite, 3, "DeleteEntryFromSpriteCache, inuse={}", GetSpriteCacheUsage());
+	/* Two rounds: the first one may only clear the referenced flags. */
+	for (uint i = 0; i < 2 * _spritecache_items; i++) {
+		if (_sprite_clock_hand >= _spritecache_items) _sprite_clock_hand = 0;
 
-	cur_lru = 0xffff;
-	for (SpriteID i = 0; i != _spritecache_items; i++) {
-		SpriteCache *sc = GetSpriteCache(i);
-		if (sc->type != ST_RECOLOUR && sc->ptr != nullptr && sc->lru < cur_lru) {
-			cur_lru = sc->lru;
-			best = i;
+		uint item = _sprite_clock_hand++;
+		SpriteCache *sc = GetSpriteCache(item);
+		if (sc->type == ST_RECOLOUR || sc->ptr == nullptr) continue;
+
+		if (sc->referenced) {
+			sc->referenced = false;
+			continue;
 		}
+
+		DeleteEntryFromSpriteCache(item);
+		return;
 	}
 
 	/* Display an error message and die, in case we found no sprite at all.
 	 * This shouldn't really happen, unless all sprites are locked. */
-	if (best == UINT_MAX) error("Out of sprite memory");
-
-	DeleteEntryFromSpriteCache(best);
+	error("Out of sprite memory");
 }
 
+/**
+ * Allocate memory for a sprite in the sprite cache.
+ * Sprites never move once allocated, so the returned pointer stays
+ * valid until the sprite gets evicted from the cache.
+ * @param mem_req Number of bytes needed.
+ * @return Pointer to the memory.
+ */
 static void *AllocSprite(size_t mem_req)
 {
-	mem_req += sizeof(MemBlock);
-
-	/* Align this to correct boundary. This also makes sure at least one
-	 * bit is not used, so we can use it for other things. */
-	mem_req = Align(mem_req, S_FREE_MASK + 1);
+	uint size_class = GetSpriteSizeClass(mem_req + sizeof(MemBlock));
+	size_t bytes = GetSpriteSizeClassBytes(size_class);
+	if (size_class >= _sprite_free_blocks.size()) _sprite_free_blocks.resize(size_class + 1);
 
+	std::vector<MemBlock *> &free_blocks = _sprite_free_blocks[size_class];
+	MemBlock *block;
 	for (;;) {
-		MemBlock *s;
-
-		for (s = _spritecache_ptr; s->size != 0; s = NextBlock(s)) {
-			if (s->size & S_FREE_MASK) {
-				size_t cur_size = s->size & ~S_FREE_MASK;
-
-				/* Is the block exactly the size we need or
-				 * big enough for an additional free block? */
-				if (cur_size == mem_req ||
-						cur_size >= mem_req + sizeof(MemBlock)) {
-					/* Set size and in use */
-					s->size = mem_req;
-
-					/* Do we need to inject a free block too? */
-					if (cur_size != mem_req) {
-						NextBlock(s)->size = (cur_size - mem_req) | S_FREE_MASK;
-					}
+		if (!free_blocks.empty()) {
+			block = free_blocks.back();
+			free_blocks.pop_back();
+			_sprite_cache_spare -= bytes;
+			break;
+		}
 
-					return s->data;
-				}
-			}
+		if (_sprite_cache_used + _sprite_cache_spare + bytes <= _sprite_cache_budget) {
+			block = (MemBlock *)MallocT<byte>(bytes);
+			block->size_class = size_class;
+			break;
 		}
 
-		/* Reached sentinel, but no block found yet. Delete some old entry. */
-		DeleteEntryFromSpriteCache();
+		/* No free block of the right size and no room for a new one. Make room by
+		 * dropping the free blocks of other size classes, or else by evicting a sprite. */
+		if (_sprite_cache_spare != 0 && _sprite_cache_used + bytes <= _sprite_cache_budget) {
+			ReleaseSpareSpriteBlocks();
+		} else {
+			DeleteEntryFromSpriteCache();
+		}
 	}
+
+	_sprite_cache_used += bytes;
+	return block->data;
 }
 
 /**
@@ -932,6 +888,8 @@ static void *HandleInvalidSpriteRequest(SpriteID sprite, SpriteType requested, S
 /**
  * Reads a sprite (from disk or sprite cache).
  * If the sprite is not available or of wrong type, a fallback sprite is returned.
+ * The sprite cache is not thread safe, and the returned data may be evicted
+ * to make room when the next sprite is read.
  * @param sprite Sprite to read.
  * @param type Expected sprite type.
  * @param allocator Allocator function to use. Set to nullptr to use the usual sprite cache.
@@ -957,8 +915,8 @@ void *GetRawSprite(SpriteID sprite, SpriteType type, AllocatorProc *allocator, S
 	if (allocator == nullptr && encoder == nullptr) {
 		/* Load sprite into/from spritecache */
 
-		/* Update LRU */
-		sc->lru = ++_sprite_lru_counter;
+		/* Protect it from the next pass of the eviction clock. */
+		sc->referenced = true;
 
 		/* Load the sprite, if it is not loaded, yet */
 		if (sc->ptr == nullptr) sc->ptr = ReadSprite(sc, sprite, type, AllocSprite, nullptr);
@@ -973,53 +931,49 @@ void *GetRawSprite(SpriteID sprite, SpriteType type, AllocatorProc *allocator, S
 
 static void GfxInitSpriteCache()
 {
-	/* initialize sprite cache heap */
+	/* Throw away all cached sprites; the pool is reset after this. */
+	for (uint i = 0; i != _spritecache_items; i++) {
+		SpriteCache *sc = GetSpriteCache(i);
+		if (sc->ptr != nullptr) DeleteEntryFromSpriteCache(i);
+	}
+	ReleaseSpareSpriteBlocks();
+	assert(_sprite_cache_used == 0);
+
+	_sprite_clock_hand = 0;
+
 	int bpp = BlitterFactory::GetCurrentBlitter()->GetScreenDepth();
-	uint target_size = (bpp > 0 ? _sprite_cache_size * bpp / 8 : 1) * 1024 * 1024;
+	size_t target_size = (size_t)(bpp > 0 ? _sprite_cache_size * bpp / 8 : 1) * 1024 * 1024;
 
 	/* Remember 'target_size' from the previous allocation attempt, so we do not try to reach the target_size multiple times in case of failure. */
-	static uint last_alloc_attempt = 0;
+	static size_t last_alloc_attempt = 0;
+	if (target_size == last_alloc_attempt) return;
 
-	if (_spritecache_ptr == nullptr || (_allocated_sprite_cache_size != target_size && target_size != last_alloc_attempt)) {
-		delete[] reinterpret_cast<byte *>(_spritecache_ptr);
+	last_alloc_attempt = target_size;
+	_sprite_cache_budget = target_size;
 
-		last_alloc_attempt = target_size;
-		_allocated_sprite_cache_size = target_size;
+	/* The blocks are only allocated when sprites are loaded, so check now whether that much memory can be had at all. */
+	for (;;) {
+		/* Try to allocate 50% more to make sure we do not allocate almost all available. */
+		byte *probe = new (std::nothrow) byte[_sprite_cache_budget + _sprite_cache_budget / 2];
+		if (probe != nullptr) {
+			delete[] probe;
+			break;
+		}
 
-		do {
-			try {
-				/* Try to allocate 50% more to make sure we do not allocate almost all available. */
-				_spritecache_ptr = reinterpret_cast<MemBlock *>(new byte[_allocated_sprite_cache_size + _allocated_sprite_cache_size / 2]);
-			} catch (std::bad_alloc &) {
-				_spritecache_ptr = nullptr;
-			}
+		if (_sprite_cache_budget < 2 * 1024 * 1024) usererror("Cannot allocate spritecache");
 
-			if (_spritecache_ptr != nullptr) {
-				/* Allocation succeeded, but we wanted less. */
-				delete[] reinterpret_cast<byte *>(_spritecache_ptr);
-				_spritecache_ptr = reinterpret_cast<MemBlock *>(new byte[_allocated_sprite_cache_size]);
-			} else if (_allocated_sprite_cache_size < 2 * 1024 * 1024) {
-				usererror("Cannot allocate spritecache");
-			} else {
-				/* Try again to allocate half. */
-				_allocated_sprite_cache_size >>= 1;
-			}
-		} while (_spritecache_ptr == nullptr);
+		/* Try again with half. */
+		_sprite_cache_budget >>= 1;
+	}
 
-		if (_allocated_sprite_cache_size != target_size) {
-			Debug(misc, 0, "Not enough memory to allocate {} MiB of spritecache. Spritecache was reduced to {} MiB.", target_size / 1024 / 1024, _allocated_sprite_cache_size / 1024 / 1024);
+	if (_sprite_cache_budget != target_size) {
+		Debug(misc, 0, "Not enough memory to allocate {} MiB of spritecache. Spritecache was reduced to {} MiB.", target_size / 1024 / 1024, _sprite_cache_budget / 1024 / 1024);
 
-			ErrorMessageData msg(STR_CONFIG_ERROR_OUT_OF_MEMORY, STR_CONFIG_ERROR_SPRITECACHE_TOO_BIG);
-			msg.SetDParam(0, target_size);
-			msg.SetDParam(1, _allocated_sprite_cache_size);
-			ScheduleErrorMessage(msg);
-		}
+		ErrorMessageData msg(STR_CONFIG_ERROR_OUT_OF_MEMORY, STR_CONFIG_ERROR_SPRITECACHE_TOO_BIG);
+		msg.SetDParam(0, target_size);
+		msg.SetDParam(1, _sprite_cache_budget);
+		ScheduleErrorMessage(msg);
 	}
-
-	/* A big free block */
-	_spritecache_ptr->size = (_allocated_sprite_cache_size - sizeof(MemBlock)) | S_FREE_MASK;
-	/* Sentinel block (identified by size == 0) */
-	NextBlock(_spritecache_ptr)->size = 0;
 }
 
 void GfxInitSpriteMem()
@@ -1031,7 +985,6 @@ void GfxInitSpriteMem()
 	_spritecache_items = 0;
 	_spritecache = nullptr;
 
-	_compact_cache_counter = 0;
 	_sprite_files.clear();
 }
 
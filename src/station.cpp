@@ -406,6 +406,20 @@ void Station::RemoveFromAllNearbyLists()
 	for (Industry *i : Industry::Iterate()) { i->stations_near.erase(this); }
 }
 
+/**
+ * Remove this station from the nearby stations lists of the towns and industries in its catchment area.
+ * Houses and industry tiles keep these lists up to date when they are built or removed, so only towns
+ * and industries with a tile in the catchment area can have this station in their list.
+ */
+void Station::RemoveFromCatchmentNearbyLists()
+{
+	BitmapTileIterator it(this->catchment_tiles);
+	for (TileIndex tile = it; tile != INVALID_TILE; tile = ++it) {
+		if (IsTileType(tile, MP_HOUSE)) Town::GetByTile(tile)->stations_near.erase(this);
+		if (IsTileType(tile, MP_INDUSTRY)) Industry::GetByTile(tile)->stations_near.erase(this);
+	}
+}
+
 /**
  * Test if the given town ID is covered by our catchment area.
  * This is used when removing a house tile to determine if it was the last house tile
@@ -425,11 +439,12 @@ bool Station::CatchmentCoversTown(TownID t) const
 /**
  * Recompute tiles covered in our catchment area.
  * This will additionally recompute nearby towns and industries.
+ * @param clear_nearby_lists Whether to remove this station from the nearby stations lists of towns and industries first; unset when those lists have already been cleared.
  */
-void Station::RecomputeCatchment()
+void Station::RecomputeCatchment(bool clear_nearby_lists)
 {
 	this->industries_near.clear();
-	this->RemoveFromAllNearbyLists();
+	if (clear_nearby_lists) this->RemoveFromCatchmentNearbyLists();
 
 	if (this->rect.IsEmpty()) {
 		this->catchment_tiles.Reset();
@@ -496,7 +511,9 @@ void Station::RecomputeCatchment()
  */
 /* static */ void Station::RecomputeCatchmentForAll()
 {
-	for (Station *st : Station::Iterate()) { st->RecomputeCatchment(); }
+	for (Town *t : Town::Iterate()) { t->stations_near.clear(); }
+	for (Industry *i : Industry::Iterate()) { i->stations_near.clear(); }
+	for (Station *st : Station::Iterate()) { st->RecomputeCatchment(false); }
 }
 
 /************************************************************************/
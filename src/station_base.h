@@ -501,7 +501,7 @@ public:
 
 	uint GetPlatformLength(TileIndex tile, DiagDirection dir) const override;
 	uint GetPlatformLength(TileIndex tile) const override;
-	void RecomputeCatchment();
+	void RecomputeCatchment(bool clear_nearby_lists = true);
 	static void RecomputeCatchmentForAll();
 
 	uint GetCatchmentRadius() const;
@@ -510,6 +510,7 @@ public:
 	void AddIndustryToDeliver(Industry *ind, TileIndex tile);
 	void RemoveIndustryToDeliver(Industry *ind);
 	void RemoveFromAllNearbyLists();
+	void RemoveFromCatchmentNearbyLists();
 
 	inline bool TileIsInCatchment(TileIndex tile) const
 	{
@@ -1981,7 +1981,7 @@ static CommandCost RemoveRoadStop(TileIndex tile, DoCommandFlag flags)
 	/* don't do the check for drive-through road stops when company bankrupts */
 	if (IsDriveThroughStopTile(tile) && (flags & DC_BANKRUPT)) {
 		/* remove the 'going through road stop' status from all vehicles on that tile */
-		if (flags & DC_EXEC) FindVehicleOnPos(tile, nullptr, &ClearRoadStopStatusEnum);
+		if (flags & DC_EXEC) FindRoadVehicleOnPos(tile, nullptr, &ClearRoadStopStatusEnum);
 	} else {
 		CommandCost ret = EnsureNoVehicleOnGround(tile);
 		if (ret.Failed()) return ret;
@@ -3426,6 +3426,9 @@ static void UpdateStationRating(Station *st)
 	byte_inc_sat(&st->time_since_load);
 	byte_inc_sat(&st->time_since_unload);
 
+	/* A statue in the town improves the rating of all cargos of the owner's stations. */
+	const bool has_statue = Company::IsValidID(st->owner) && st->town->statues.at(st->owner);
+
 	for (const CargoSpec *cs : CargoSpec::Iterate()) {
 		GoodsEntry *ge = &st->goods[cs->Index()];
 		/* Slowly increase the rating back to its original level in the case we
@@ -3504,7 +3507,7 @@ static void UpdateStationRating(Station *st)
 				if (ge->max_waiting_cargo <= 100) rating += 10;
 			}
 
-			if (Company::IsValidID(st->owner) && st->town->statues.at(st->owner)) rating += 26;
+			if (has_statue) rating += 26;
 
 			byte age = ge->last_age;
 			if (age < 3) rating += 10;
@@ -3774,11 +3777,9 @@ static void StationHandleSmallTick(BaseStation *st)
 {
 	if ((st->facilities & FACIL_WAYPOINT) != 0 || !st->IsInUse()) return;
 
-	byte b = st->delete_ctr + 1;
-	if (b >= STATION_RATING_TICKS) b = 0;
-	st->delete_ctr = b;
-
-	if (b == 0) UpdateStationRating(Station::From(st));
+	/* Station index is included so that the ratings of all stations
+	 * are not updated at the same time. */
+	if ((_tick_counter + st->index) % STATION_RATING_TICKS == 0) UpdateStationRating(Station::From(st));
 }
 
 void OnTick_Station()
@@ -4011,20 +4012,36 @@ uint MoveGoodsToStation(CargoID type, uint amount, SourceType source_type, Sourc
 		return UpdateStationWaiting(first_station, type, amount, source_type, source_id);
 	}
 
-	uint company_best[OWNER_NONE + 1] = {};  // best rating for each company, including OWNER_NONE
-	uint company_sum[OWNER_NONE + 1] = {};   // sum of ratings for each company
+	/* Best rating and sum of ratings for each company, including OWNER_NONE, with a station here.
+	 * There are never more companies than stations, so these fit in arrays on the stack that are
+	 * a lot cheaper than clearing per-owner arrays for all possible companies on every call. */
+	struct CompanyRating {
+		Owner owner; ///< The company.
+		uint best;   ///< Best rating of the company's stations.
+		uint sum;    ///< Sum of the ratings of the company's stations.
+	};
+	CompanyRating *company_ratings = AllocaM(CompanyRating, used_stations.size());
+	uint *station_company = AllocaM(uint, used_stations.size()); // index in company_ratings for each of used_stations
+	uint num_companies = 0;
+
 	uint best_rating = 0;
 	uint best_sum = 0;  // sum of best ratings for each company
 
-	for (auto &p : used_stations) {
-		auto owner = p.first->owner;
-		auto rating = p.first->goods[type].rating;
-		if (rating > company_best[owner]) {
-			best_sum += rating - company_best[owner];  // it's usually faster than iterating companies later
-			company_best[owner] = rating;
+	for (uint i = 0; i < used_stations.size(); i++) {
+		const Station *st = used_stations[i].first;
+		uint c = 0;
+		while (c < num_companies && company_ratings[c].owner != st->owner) c++;
+		if (c == num_companies) company_ratings[num_companies++] = {st->owner, 0, 0};
+		station_company[i] = c;
+
+		CompanyRating &cr = company_ratings[c];
+		uint rating = st->goods[type].rating;
+		if (rating > cr.best) {
+			best_sum += rating - cr.best;  // it's usually faster than iterating companies later
+			cr.best = rating;
 			if (rating > best_rating) best_rating = rating;
 		}
-		company_sum[owner] += rating;
+		cr.sum += rating;
 	}
 
 	/* From now we'll calculate with fractional cargo amounts.
@@ -4032,11 +4049,12 @@ uint MoveGoodsToStation(CargoID type, uint amount, SourceType source_type, Sourc
 	amount *= best_rating + 1;
 
 	uint moving = 0;
-	for (auto &p : used_stations) {
-		uint owner = p.first->owner;
+	for (uint i = 0; i < used_stations.size(); i++) {
+		StationInfo &p = used_stations[i];
+		const CompanyRating &cr = company_ratings[station_company[i]];
 		/* Multiply the amount by (company best / sum of best for each company) to get cargo allocated to a company
 		 * and by (station rating / sum of ratings in a company) to get the result for a single station. */
-		p.second = amount * company_best[owner] * p.first->goods[type].rating / best_sum / company_sum[owner];
+		p.second = amount * cr.best * p.first->goods[type].rating / best_sum / cr.sum;
 		moving += p.second;
 	}
 
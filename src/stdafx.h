@@ -430,10 +430,12 @@ static_assert(SIZE_MAX >= UINT32_MAX);
 #	define likely(x)     __builtin_expect(!!(x), 1)
 #	define unlikely(x)   __builtin_expect(!!(x), 0)
 #	define GNU_TARGET(x) [[gnu::target(x)]]
+#	define PREFETCH(x)   __builtin_prefetch(x)
 #else
 #	define likely(x)     (x)
 #	define unlikely(x)   (x)
 #	define GNU_TARGET(x)
+#	define PREFETCH(x)
 #endif /* __GNUC__ || __clang__ */
 
 /* For the FMT library we only want to use the headers, not link to some library. */
@@ -80,12 +80,15 @@ struct Town : TownPool::PoolItem<&_town_pool> {
 
 	inline byte GetPercentTransported(CargoID cid) const { return this->supplied[cid].old_act * 256 / (this->supplied[cid].old_max + 1); }
 
+	uint16 GetGrowCounter() const;
+
 	StationList stations_near;       ///< NOSAVE: List of nearby stations.
 
 	uint16 time_until_rebuild;       ///< time until we rebuild a house
 
-	uint16 grow_counter;             ///< counter to count when to grow, value is smaller than or equal to growth_rate
+	uint16 grow_counter;             ///< counter to count when to grow, value is smaller than or equal to growth_rate; not updated while the town is scheduled to grow, @see GetGrowCounter()
 	uint16 growth_rate;              ///< town growth rate
+	uint64 next_grow_tick;           ///< NOSAVE: Town tick on which the town grows next, 0 if it is not scheduled to grow.
 
 	byte fund_buildings_months;      ///< fund buildings program in action?
 	byte road_build_months;          ///< fund road reconstruction in action?
@@ -151,6 +154,7 @@ void ShowTownViewWindow(TownID town);
 void ExpandTown(Town *t);
 
 void RebuildTownKdtree();
+void RebuildTownGrowthSchedule();
 
 /** Settings for town council attitudes. */
 enum TownCouncilAttitudes {
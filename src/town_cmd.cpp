@@ -74,6 +74,59 @@ void RebuildTownKdtree()
 	_town_kdtree.Build(townids.begin(), townids.end());
 }
 
+/** Number of town ticks that have run; only meaningful relative to Town::next_grow_tick. */
+static uint64 _town_ticks = 0;
+/** Growing towns, ordered by the town tick they grow on next and then by their index. */
+static std::set<std::pair<uint64, TownID>> _town_growth_schedule;
+
+/**
+ * Remove a town from the growth schedule, storing the ticks left until it would grow in its grow counter.
+ * @param t The town to remove.
+ */
+static void UnscheduleTownGrowth(Town *t)
+{
+	if (t->next_grow_tick == 0) return;
+
+	t->grow_counter = t->GetGrowCounter();
+	_town_growth_schedule.erase(std::make_pair(t->next_grow_tick, t->index));
+	t->next_grow_tick = 0;
+}
+
+/**
+ * Add a town to the growth schedule, if it is growing, based on its grow counter.
+ * @param t The town to add.
+ */
+static void ScheduleTownGrowth(Town *t)
+{
+	UnscheduleTownGrowth(t);
+	if (!HasBit(t->flags, TOWN_IS_GROWING)) return;
+
+	/* A town with a grow counter of 0 grows in the next town tick. */
+	t->next_grow_tick = _town_ticks + t->grow_counter + 1;
+	_town_growth_schedule.insert(std::make_pair(t->next_grow_tick, t->index));
+}
+
+/** Rebuild the growth schedule from the grow counters of all towns. */
+void RebuildTownGrowthSchedule()
+{
+	_town_growth_schedule.clear();
+	for (Town *t : Town::Iterate()) {
+		t->next_grow_tick = 0;
+		ScheduleTownGrowth(t);
+	}
+}
+
+/**
+ * Get the number of town ticks until this town grows.
+ * @return The grow counter of the town.
+ */
+uint16 Town::GetGrowCounter() const
+{
+	if (this->next_grow_tick == 0) return this->grow_counter;
+	if (this->next_grow_tick <= _town_ticks) return 0;
+	return (uint16)(this->next_grow_tick - _town_ticks - 1);
+}
+
 
 /**
  * Check if a town 'owns' a bridge.
@@ -104,6 +157,8 @@ Town::~Town()
 {
 	if (CleaningPool()) return;
 
+	UnscheduleTownGrowth(this);
+
 	/* Delete town authority window
 	 * and remove from list of sorted towns */
 	CloseWindowById(WC_TOWN_VIEW, this->index);
@@ -815,26 +870,32 @@ static bool GrowTown(Town *t);
 
 static void TownTickHandler(Town *t)
 {
-	if (HasBit(t->flags, TOWN_IS_GROWING)) {
-		int i = (int)t->grow_counter - 1;
-		if (i < 0) {
-			if (GrowTown(t)) {
-				i = t->growth_rate;
-			} else {
-				/* If growth failed wait a bit before retrying */
-				i = std::min<uint16>(t->growth_rate, TOWN_GROWTH_TICKS - 1);
-			}
-		}
-		t->grow_counter = i;
+	/* The grow counter of the town ran out. */
+	UnscheduleTownGrowth(t);
+	t->grow_counter = 0;
+
+	uint16 i;
+	if (GrowTown(t)) {
+		i = t->growth_rate;
+	} else {
+		/* If growth failed wait a bit before retrying */
+		i = std::min<uint16>(t->growth_rate, TOWN_GROWTH_TICKS - 1);
 	}
+
+	UnscheduleTownGrowth(t);
+	t->grow_counter = i;
+	ScheduleTownGrowth(t);
 }
 
 void OnTick_Town()
 {
 	if (_game_mode == GM_EDITOR) return;
 
-	for (Town *t : Town::Iterate()) {
-		TownTickHandler(t);
+	/* Only the towns that are due to grow in this tick are visited, in the
+	 * order of their index, like when looping over all towns. */
+	_town_ticks++;
+	while (!_town_growth_schedule.empty() && _town_growth_schedule.begin()->first <= _town_ticks) {
+		TownTickHandler(Town::Get(_town_growth_schedule.begin()->second));
 	}
 }
 
@@ -2877,6 +2938,7 @@ CommandCost CmdTownGrowthRate(DoCommandFlag flags, TownID town_id, uint16 growth
 			/* Just clear the flag, UpdateTownGrowth will determine a proper growth rate */
 			ClrBit(t->flags, TOWN_CUSTOM_GROWTH);
 		} else {
+			UnscheduleTownGrowth(t);
 			uint old_rate = t->growth_rate;
 			if (t->grow_counter >= old_rate) {
 				/* This also catches old_rate == 0 */
@@ -3213,7 +3275,9 @@ static CommandCost TownActionFundBuildings(Town *t, DoCommandFlag flags)
 		 * tick-perfect and gives player some time window where they can
 		 * spam funding with the exact same efficiency.
 		 */
+		UnscheduleTownGrowth(t);
 		t->grow_counter = std::min<uint16>(t->grow_counter, 2 * TOWN_GROWTH_TICKS - (t->growth_rate - t->grow_counter) % TOWN_GROWTH_TICKS);
+		ScheduleTownGrowth(t);
 
 		SetWindowDirty(WC_TOWN_VIEW, t->index);
 	}
@@ -3480,19 +3544,19 @@ static void UpdateTownGrowthRate(Town *t)
 {
 	if (HasBit(t->flags, TOWN_CUSTOM_GROWTH)) return;
 	uint old_rate = t->growth_rate;
+	UnscheduleTownGrowth(t);
 	t->growth_rate = GetNormalGrowthRate(t);
 	UpdateTownGrowCounter(t, old_rate);
+	ScheduleTownGrowth(t);
 	SetWindowDirty(WC_TOWN_VIEW, t->index);
 }
 
 /**
- * Updates town growth state (whether it is growing or not).
- * @param t The town to update growth for
+ * Updates whether the town is growing.
+ * @param t The town to update the flag for
  */
-static void UpdateTownGrowth(Town *t)
+static void UpdateTownIsGrowing(Town *t)
 {
-	UpdateTownGrowthRate(t);
-
 	ClrBit(t->flags, TOWN_IS_GROWING);
 	SetWindowDirty(WC_TOWN_VIEW, t->index);
 
@@ -3527,6 +3591,17 @@ static void UpdateTownGrowth(Town *t)
 	SetWindowDirty(WC_TOWN_VIEW, t->index);
 }
 
+/**
+ * Updates town growth state (whether it is growing or not).
+ * @param t The town to update growth for
+ */
+static void UpdateTownGrowth(Town *t)
+{
+	UpdateTownGrowthRate(t);
+	UpdateTownIsGrowing(t);
+	ScheduleTownGrowth(t);
+}
+
 static void UpdateTownAmounts(Town *t)
 {
 	for (CargoID i = 0; i < NUM_CARGO; i++) t->supplied[i].NewMonth();
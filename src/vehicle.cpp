@@ -378,16 +378,46 @@ const int TOTAL_HASH_MASK = TOTAL_HASH_SIZE - 1;
 const int HASH_RES = 0;
 
 static Vehicle *_vehicle_tile_hash[TOTAL_HASH_SIZE];
+/** The same hash as #_vehicle_tile_hash, with only the road vehicles, in the same order. */
+static RoadVehicle *_road_vehicle_tile_hash[TOTAL_HASH_SIZE];
 
-static Vehicle *VehicleFromTileHash(int xl, int yl, int xu, int yu, void *data, VehicleFromPosProc *proc, bool find_first)
+/**
+ * Call \a proc for the vehicles in one chain of the tile hash.
+ * @param hash The index of the chain in the hash.
+ * @param tile The tile the vehicles must be on, or INVALID_TILE for all vehicles in the chain.
+ * @param data Arbitrary data passed to \a proc.
+ * @param proc The proc that determines whether a vehicle will be "found".
+ * @param find_first Whether to return on the first found or iterate over all vehicles.
+ * @param road_only Whether only road vehicles have to be considered.
+ * @return the first vehicle found by \a proc when \a find_first is set, otherwise nullptr.
+ */
+static Vehicle *VehicleFromHashChain(int hash, TileIndex tile, void *data, VehicleFromPosProc *proc, bool find_first, bool road_only)
+{
+	if (road_only) {
+		for (RoadVehicle *v = _road_vehicle_tile_hash[hash]; v != nullptr; v = v->hash_road_next) {
+			if (tile != INVALID_TILE && v->tile != tile) continue;
+
+			Vehicle *a = proc(v, data);
+			if (find_first && a != nullptr) return a;
+		}
+		return nullptr;
+	}
+
+	for (Vehicle *v = _vehicle_tile_hash[hash]; v != nullptr; v = v->hash_tile_next) {
+		if (tile != INVALID_TILE && v->tile != tile) continue;
+
+		Vehicle *a = proc(v, data);
+		if (find_first && a != nullptr) return a;
+	}
+	return nullptr;
+}
+
+static Vehicle *VehicleFromTileHash(int xl, int yl, int xu, int yu, void *data, VehicleFromPosProc *proc, bool find_first, bool road_only)
 {
 	for (int y = yl; ; y = (y + (1 << HASH_BITS)) & (HASH_MASK << HASH_BITS)) {
 		for (int x = xl; ; x = (x + 1) & HASH_MASK) {
-			Vehicle *v = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
-			for (; v != nullptr; v = v->hash_tile_next) {
-				Vehicle *a = proc(v, data);
-				if (find_first && a != nullptr) return a;
-			}
+			Vehicle *a = VehicleFromHashChain((x + y) & TOTAL_HASH_MASK, INVALID_TILE, data, proc, find_first, road_only);
+			if (find_first && a != nullptr) return a;
 			if (x == xu) break;
 		}
 		if (y == yu) break;
@@ -406,9 +436,10 @@ static Vehicle *VehicleFromTileHash(int xl, int yl, int xu, int yu, void *data,
  * @param proc The proc that determines whether a vehicle will be "found".
  * @param find_first Whether to return on the first found or iterate over
  *                   all vehicles
+ * @param road_only Whether only road vehicles have to be considered.
  * @return the best matching or first vehicle (depending on find_first).
  */
-static Vehicle *VehicleFromPosXY(int x, int y, void *data, VehicleFromPosProc *proc, bool find_first)
+static Vehicle *VehicleFromPosXY(int x, int y, void *data, VehicleFromPosProc *proc, bool find_first, bool road_only = false)
 {
 	const int COLL_DIST = 6;
 
@@ -418,7 +449,7 @@ static Vehicle *VehicleFromPosXY(int x, int y, void *data, VehicleFromPosProc *p
 	int yl = GB((y - COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS) << HASH_BITS;
 	int yu = GB((y + COLL_DIST) / TILE_SIZE, HASH_RES, HASH_BITS) << HASH_BITS;
 
-	return VehicleFromTileHash(xl, yl, xu, yu, data, proc, find_first);
+	return VehicleFromTileHash(xl, yl, xu, yu, data, proc, find_first, road_only);
 }
 
 /**
@@ -456,6 +487,20 @@ bool HasVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc)
 	return VehicleFromPosXY(x, y, data, proc, true) != nullptr;
 }
 
+/**
+ * Find a road vehicle from a specific location, like #FindVehicleOnPosXY, but
+ * only calling \a proc for road vehicles. Those are called in the same order
+ * as #FindVehicleOnPosXY would.
+ * @param x    The X location on the map
+ * @param y    The Y location on the map
+ * @param data Arbitrary data passed to proc
+ * @param proc The proc that determines whether a vehicle will be "found".
+ */
+void FindRoadVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc)
+{
+	VehicleFromPosXY(x, y, data, proc, false, true);
+}
+
 /**
  * Helper function for FindVehicleOnPos/HasVehicleOnPos.
  * @note Do not call this function directly!
@@ -464,22 +509,15 @@ bool HasVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc)
  * @param proc The proc that determines whether a vehicle will be "found".
  * @param find_first Whether to return on the first found or iterate over
  *                   all vehicles
+ * @param road_only Whether only road vehicles have to be considered.
  * @return the best matching or first vehicle (depending on find_first).
  */
-static Vehicle *VehicleFromPos(TileIndex tile, void *data, VehicleFromPosProc *proc, bool find_first)
+static Vehicle *VehicleFromPos(TileIndex tile, void *data, VehicleFromPosProc *proc, bool find_first, bool road_only = false)
 {
 	int x = GB(TileX(tile), HASH_RES, HASH_BITS);
 	int y = GB(TileY(tile), HASH_RES, HASH_BITS) << HASH_BITS;
 
-	Vehicle *v = _vehicle_tile_hash[(x + y) & TOTAL_HASH_MASK];
-	for (; v != nullptr; v = v->hash_tile_next) {
-		if (v->tile != tile) continue;
-
-		Vehicle *a = proc(v, data);
-		if (find_first && a != nullptr) return a;
-	}
-
-	return nullptr;
+	return VehicleFromHashChain((x + y) & TOTAL_HASH_MASK, tile, data, proc, find_first, road_only);
 }
 
 /**
@@ -515,6 +553,32 @@ bool HasVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc)
 	return VehicleFromPos(tile, data, proc, true) != nullptr;
 }
 
+/**
+ * Find a road vehicle from a specific location, like #FindVehicleOnPos, but
+ * only calling \a proc for road vehicles. Those are called in the same order
+ * as #FindVehicleOnPos would.
+ * @param tile The location on the map
+ * @param data Arbitrary data passed to \a proc.
+ * @param proc The proc that determines whether a vehicle will be "found".
+ */
+void FindRoadVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc)
+{
+	VehicleFromPos(tile, data, proc, false, true);
+}
+
+/**
+ * Checks whether a road vehicle is on a specific location, like
+ * #HasVehicleOnPos, but only calling \a proc for road vehicles.
+ * @param tile The location on the map
+ * @param data Arbitrary data passed to \a proc.
+ * @param proc The \a proc that determines whether a vehicle will be "found".
+ * @return True if proc returned non-nullptr.
+ */
+bool HasRoadVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc)
+{
+	return VehicleFromPos(tile, data, proc, true, true) != nullptr;
+}
+
 /**
  * Callback that returns 'real' vehicles lower or at height \c *(int*)data .
  * @param v Vehicle to examine.
@@ -638,6 +702,22 @@ static void UpdateVehicleTileHash(Vehicle *v, bool remove)
 		*new_hash = v;
 	}
 
+	/* Road vehicles are also in their own hash, at the same position */
+	if (v->type == VEH_ROAD) {
+		RoadVehicle *rv = RoadVehicle::From(v);
+		if (old_hash != nullptr) {
+			if (rv->hash_road_next != nullptr) rv->hash_road_next->hash_road_prev = rv->hash_road_prev;
+			*rv->hash_road_prev = rv->hash_road_next;
+		}
+		if (new_hash != nullptr) {
+			RoadVehicle **new_road_hash = &_road_vehicle_tile_hash[new_hash - _vehicle_tile_hash];
+			rv->hash_road_next = *new_road_hash;
+			if (rv->hash_road_next != nullptr) rv->hash_road_next->hash_road_prev = &rv->hash_road_next;
+			rv->hash_road_prev = new_road_hash;
+			*new_road_hash = rv;
+		}
+	}
+
 	/* Remember current hash position */
 	v->hash_tile_current = new_hash;
 }
@@ -673,6 +753,7 @@ void ResetVehicleHash()
 	for (Vehicle *v : Vehicle::Iterate()) { v->hash_tile_current = nullptr; }
 	memset(_vehicle_viewport_hash, 0, sizeof(_vehicle_viewport_hash));
 	memset(_vehicle_tile_hash, 0, sizeof(_vehicle_tile_hash));
+	memset(_road_vehicle_tile_hash, 0, sizeof(_road_vehicle_tile_hash));
 }
 
 void ResetVehicleColourMap()
@@ -21,6 +21,7 @@
 #include "transport_type.h"
 #include "group_type.h"
 #include "base_consist.h"
+#include "newgrf_properties.h"
 #include "network/network.h"
 #include "saveload/saveload.h"
 #include <list>
@@ -76,6 +77,62 @@ struct NewGRFCache {
 	uint8  cache_valid;               ///< Bitset that indicates which cache values are valid.
 };
 
+/**
+ * Cache of callback 36 results of a vehicle.
+ * Only results of chains that do not read changing variables are stored, see #SpriteGroup::cacheable.
+ * This is kept out of #NewGRFCache as its entries are filled on demand; CheckCaches resolves them again instead.
+ */
+struct NewGRFPropertyCache {
+	static const uint SIZE = 8;       ///< Number of properties that are remembered.
+
+	uint8 count;                      ///< Number of valid entries.
+	uint8 next;                       ///< Entry to replace when the cache is full.
+	PropertyID property[SIZE];        ///< Cached properties.
+	uint16 value[SIZE];               ///< Callback results of the cached properties.
+
+	/**
+	 * Look up a cached callback result.
+	 * @param prop The property to look up.
+	 * @param[out] result The cached callback result.
+	 * @return True iff the property was cached.
+	 */
+	inline bool Get(PropertyID prop, uint16 &result) const
+	{
+		for (uint i = 0; i < this->count; i++) {
+			if (this->property[i] == prop) {
+				result = this->value[i];
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Store a callback result, replacing the oldest entry when the cache is full.
+	 * @param prop The property to store.
+	 * @param result The callback result.
+	 */
+	inline void Set(PropertyID prop, uint16 result)
+	{
+		uint i;
+		if (this->count < SIZE) {
+			i = this->count++;
+		} else {
+			i = this->next;
+			this->next = (this->next + 1) % SIZE;
+		}
+		this->property[i] = prop;
+		this->value[i] = result;
+	}
+
+	/** Forget all cached results. */
+	inline void Clear()
+	{
+		this->count = 0;
+		this->next = 0;
+	}
+};
+
 /** Meaning of the various bits of the visual effect. */
 enum VisualEffect {
 	VE_OFFSET_START        = 0, ///< First bit that contains the offset (0 = front, 8 = centre, 15 = rear)
@@ -342,6 +399,7 @@ public:
 	byte subtype;                       ///< subtype (Filled with values from #AircraftSubType/#DisasterSubType/#EffectVehicleType/#GroundVehicleSubtypeFlags)
 
 	NewGRFCache grf_cache;              ///< Cache of often used calculated NewGRF values
+	mutable NewGRFPropertyCache grf_property_cache; ///< Cache of callback 36 results, see #GetVehicleProperty
 	VehicleCache vcache;                ///< Cache of often used vehicle values.
 
 	mutable MutableSpriteCache sprite_cache; ///< Cache of sprites and values related to recalculating them, see #MutableSpriteCache
@@ -478,6 +536,7 @@ public:
 	inline void InvalidateNewGRFCache()
 	{
 		this->grf_cache.cache_valid = 0;
+		this->grf_property_cache.Clear();
 	}
 
 	/**
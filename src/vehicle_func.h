@@ -44,6 +44,9 @@ void FindVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc);
 void FindVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc);
 bool HasVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc);
 bool HasVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc);
+void FindRoadVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc);
+void FindRoadVehicleOnPosXY(int x, int y, void *data, VehicleFromPosProc *proc);
+bool HasRoadVehicleOnPos(TileIndex tile, void *data, VehicleFromPosProc *proc);
 void CallVehicleTicks();
 uint8 CalcPercentVehicleFilled(const Vehicle *v, StringID *colour);
 
@@ -89,9 +89,13 @@
 #include "network/network_func.h"
 #include "framerate_type.h"
 #include "viewport_cmd.h"
+#include "settings_type.h"
+#include "thread.h"
 
+#include <condition_variable>
 #include <forward_list>
 #include <map>
+#include <mutex>
 #include <stack>
 
 #include "table/strings.h"
@@ -1726,7 +1730,15 @@ static void ViewportDrawStrings(ZoomLevel zoom, const StringSpriteToDrawVector *
 	}
 }
 
-void ViewportDoDraw(const Viewport *vp, int left, int top, int right, int bottom)
+/**
+ * Collect the sprites of a part of a viewport into #_vd, without drawing them yet.
+ * @param vp     Viewport to draw.
+ * @param left   Left edge of the area to draw, in virtual coordinates.
+ * @param top    Top edge of the area to draw, in virtual coordinates.
+ * @param right  Right edge of the area to draw, in virtual coordinates.
+ * @param bottom Bottom edge of the area to draw, in virtual coordinates.
+ */
+static void ViewportCollectSprites(const Viewport *vp, int left, int top, int right, int bottom)
 {
 	DrawPixelInfo *old_dpi = _cur_dpi;
 	_cur_dpi = &_vd.dpi;
@@ -1755,36 +1767,75 @@ void ViewportDoDraw(const Viewport *vp, int left, int top, int right, int bottom
 
 	DrawTextEffects(&_vd.dpi);
 
-	if (_vd.tile_sprites_to_draw.size() != 0) ViewportDrawTileSprites(&_vd.tile_sprites_to_draw);
-
 	for (auto &psd : _vd.parent_sprites_to_draw) {
 		_vd.parent_sprites_to_sort.push_back(&psd);
 	}
 
-	_vp_sprite_sorter(&_vd.parent_sprites_to_sort);
+	_cur_dpi = old_dpi;
+}
+
+/**
+ * Draw the sprites collected by #ViewportCollectSprites, after the parent sprites have been sorted.
+ */
+static void ViewportDrawCollectedSprites()
+{
+	DrawPixelInfo *old_dpi = _cur_dpi;
+	_cur_dpi = &_vd.dpi;
+
+	if (_vd.tile_sprites_to_draw.size() != 0) ViewportDrawTileSprites(&_vd.tile_sprites_to_draw);
+
 	ViewportDrawParentSprites(&_vd.parent_sprites_to_sort, &_vd.child_screen_sprites_to_draw);
 
 	if (_draw_bounding_boxes) ViewportDrawBoundingBoxes(&_vd.parent_sprites_to_sort);
 	if (_draw_dirty_blocks) ViewportDrawDirtyBlocks();
 
-	DrawPixelInfo dp = _vd.dpi;
-	ZoomLevel zoom = _vd.dpi.zoom;
+	_cur_dpi = old_dpi;
+}
+
+/**
+ * Draw the link graph overlay of a viewport over the sprites.
+ * @param vp  Viewport to draw.
+ * @param dpi Area of the viewport to draw, in virtual coordinates.
+ */
+static void ViewportDrawOverlay(const Viewport *vp, const DrawPixelInfo &dpi)
+{
+	if (vp->overlay == nullptr || vp->overlay->GetCargoMask() == 0 || vp->overlay->GetCompanyMask().none()) return;
+
+	DrawPixelInfo *old_dpi = _cur_dpi;
+
+	int mask = ScaleByZoom(-1, vp->zoom);
+	DrawPixelInfo dp = dpi;
 	dp.zoom = ZOOM_LVL_NORMAL;
-	dp.width = UnScaleByZoom(dp.width, zoom);
-	dp.height = UnScaleByZoom(dp.height, zoom);
+	dp.width = UnScaleByZoom(dp.width, dpi.zoom);
+	dp.height = UnScaleByZoom(dp.height, dpi.zoom);
+	/* translate to window coordinates */
+	dp.left = UnScaleByZoom(dpi.left - (vp->virtual_left & mask), vp->zoom) + vp->left;
+	dp.top = UnScaleByZoom(dpi.top - (vp->virtual_top & mask), vp->zoom) + vp->top;
 	_cur_dpi = &dp;
 
-	if (vp->overlay != nullptr && vp->overlay->GetCargoMask() != 0 && vp->overlay->GetCompanyMask().any()) {
-		/* translate to window coordinates */
-		dp.left = x;
-		dp.top = y;
-		vp->overlay->Draw(&dp);
-	}
+	vp->overlay->Draw(&dp);
+
+	_cur_dpi = old_dpi;
+}
+
+/**
+ * Draw the strings collected by #ViewportCollectSprites, and clear all collected sprites.
+ */
+static void ViewportDrawCollectedStrings()
+{
+	DrawPixelInfo *old_dpi = _cur_dpi;
 
 	if (_vd.string_sprites_to_draw.size() != 0) {
+		DrawPixelInfo dp = _vd.dpi;
+		ZoomLevel zoom = _vd.dpi.zoom;
+		dp.zoom = ZOOM_LVL_NORMAL;
+		dp.width = UnScaleByZoom(dp.width, zoom);
+		dp.height = UnScaleByZoom(dp.height, zoom);
 		/* translate to world coordinates */
 		dp.left = UnScaleByZoom(_vd.dpi.left, zoom);
 		dp.top = UnScaleByZoom(_vd.dpi.top, zoom);
+		_cur_dpi = &dp;
+
 		ViewportDrawStrings(zoom, &_vd.string_sprites_to_draw);
 	}
 
@@ -1797,6 +1848,160 @@ void ViewportDoDraw(const Viewport *vp, int left, int top, int right, int bottom
 	_vd.child_screen_sprites_to_draw.clear();
 }
 
+void ViewportDoDraw(const Viewport *vp, int left, int top, int right, int bottom)
+{
+	ViewportCollectSprites(vp, left, top, right, bottom);
+	_vp_sprite_sorter(&_vd.parent_sprites_to_sort);
+	ViewportDrawCollectedSprites();
+	ViewportDrawOverlay(vp, _vd.dpi);
+	ViewportDrawCollectedStrings();
+}
+
+/**
+ * Threads that sort the parent sprites of the bands of a viewport, see #ViewportDoDrawBands.
+ * The threads are started when they are first needed, and then wait for more work until the game exits.
+ */
+class ViewportSortWorkers {
+	std::vector<std::thread> threads;             ///< The worker threads.
+	std::mutex lock;                              ///< Lock for the members below.
+	std::condition_variable work_available;       ///< Signalled when sprites are queued for sorting, or when the workers have to stop.
+	std::condition_variable work_done;            ///< Signalled when all queued sprites have been sorted.
+	std::vector<ParentSpriteToSortVector *> jobs; ///< Lists of sprites waiting to be sorted.
+	uint busy = 0;                                ///< Number of lists queued or being sorted.
+	bool stop = false;                            ///< Whether the workers have to exit.
+
+	/** Main loop of a worker thread. */
+	void Run()
+	{
+		std::unique_lock<std::mutex> lk(this->lock);
+		for (;;) {
+			this->work_available.wait(lk, [this]() { return this->stop || !this->jobs.empty(); });
+			if (this->stop) return;
+
+			ParentSpriteToSortVector *psdv = this->jobs.back();
+			this->jobs.pop_back();
+
+			lk.unlock();
+			_vp_sprite_sorter(psdv);
+			lk.lock();
+
+			if (--this->busy == 0) this->work_done.notify_all();
+		}
+	}
+
+public:
+	~ViewportSortWorkers()
+	{
+		{
+			std::lock_guard<std::mutex> lk(this->lock);
+			this->stop = true;
+		}
+		this->work_available.notify_all();
+		for (std::thread &thread : this->threads) thread.join();
+	}
+
+	/**
+	 * Start worker threads until the given number of them is running.
+	 * @param count Number of workers wanted.
+	 * @return Number of workers running, which is less than \a count if threads can not be started.
+	 */
+	uint Reserve(uint count)
+	{
+		while (this->threads.size() < count) {
+			std::thread thread;
+			if (!StartNewThread(&thread, "ottd:vp-sort", [this]() { this->Run(); })) break;
+			this->threads.push_back(std::move(thread));
+		}
+		return (uint)this->threads.size();
+	}
+
+	/**
+	 * Queue a list of parent sprites to be sorted by one of the workers.
+	 * @param psdv The sprites to sort.
+	 */
+	void Sort(ParentSpriteToSortVector *psdv)
+	{
+		{
+			std::lock_guard<std::mutex> lk(this->lock);
+			this->jobs.push_back(psdv);
+			this->busy++;
+		}
+		this->work_available.notify_one();
+	}
+
+	/** Wait until all queued sprites have been sorted. */
+	void Wait()
+	{
+		std::unique_lock<std::mutex> lk(this->lock);
+		this->work_done.wait(lk, [this]() { return this->busy == 0; });
+	}
+};
+
+static const int VIEWPORT_MIN_BAND_HEIGHT = 64;       ///< Minimum height in pixels of a band of a viewport.
+static const size_t VIEWPORT_MIN_THREADED_SORT = 256; ///< Minimum number of parent sprites in a band to sort it on a worker thread.
+static std::vector<ViewportDrawer> _vd_bands;         ///< Collected sprites of each band of the viewport being drawn.
+static ViewportSortWorkers _vp_sort_workers;          ///< Threads sorting the sprites of the bands.
+
+/**
+ * Draw a part of a viewport in horizontal bands, sorting the sprites of the bands on worker threads.
+ * Collecting and drawing the sprites stays on the calling thread, as those use the game state and
+ * the sprite cache; sorting only touches the collected sprites of a band. The first band is sorted
+ * on the calling thread while the workers sort the others. Sprites and strings that overlap the
+ * edge of a band are collected for every band they are in and drawn clipped to each of them; the
+ * link graph overlay is drawn once over the whole area.
+ * @param vp        Viewport to draw.
+ * @param left      Left edge of the area to draw, in screen coordinates.
+ * @param top       Top edge of the area to draw, in screen coordinates.
+ * @param right     Right edge of the area to draw, in screen coordinates.
+ * @param bottom    Bottom edge of the area to draw, in screen coordinates.
+ * @param num_bands Number of bands to draw.
+ */
+static void ViewportDoDrawBands(const Viewport *vp, int left, int top, int right, int bottom, uint num_bands)
+{
+	if (_vd_bands.size() < num_bands) _vd_bands.resize(num_bands);
+
+	for (uint i = 0; i < num_bands; i++) {
+		int band_top = top + (bottom - top) * i / num_bands;
+		int band_bottom = top + (bottom - top) * (i + 1) / num_bands;
+
+		ViewportCollectSprites(vp,
+			ScaleByZoom(left - vp->left, vp->zoom) + vp->virtual_left,
+			ScaleByZoom(band_top - vp->top, vp->zoom) + vp->virtual_top,
+			ScaleByZoom(right - vp->left, vp->zoom) + vp->virtual_left,
+			ScaleByZoom(band_bottom - vp->top, vp->zoom) + vp->virtual_top
+		);
+		std::swap(_vd, _vd_bands[i]);
+	}
+
+	bool workers = _vp_sort_workers.Reserve(num_bands - 1) > 0;
+	for (uint i = 1; i < num_bands; i++) {
+		ParentSpriteToSortVector *psdv = &_vd_bands[i].parent_sprites_to_sort;
+		if (workers && psdv->size() >= VIEWPORT_MIN_THREADED_SORT) {
+			_vp_sort_workers.Sort(psdv);
+		} else {
+			_vp_sprite_sorter(psdv);
+		}
+	}
+	_vp_sprite_sorter(&_vd_bands[0].parent_sprites_to_sort);
+	_vp_sort_workers.Wait();
+
+	for (uint i = 0; i < num_bands; i++) {
+		std::swap(_vd, _vd_bands[i]);
+		ViewportDrawCollectedSprites();
+		std::swap(_vd, _vd_bands[i]);
+	}
+
+	DrawPixelInfo dpi = _vd_bands[0].dpi;
+	dpi.height = _vd_bands[num_bands - 1].dpi.top + _vd_bands[num_bands - 1].dpi.height - dpi.top;
+	ViewportDrawOverlay(vp, dpi);
+
+	for (uint i = 0; i < num_bands; i++) {
+		std::swap(_vd, _vd_bands[i]);
+		ViewportDrawCollectedStrings();
+		std::swap(_vd, _vd_bands[i]);
+	}
+}
+
 static inline void ViewportDraw(const Viewport *vp, int left, int top, int right, int bottom)
 {
 	if (right <= vp->left || bottom <= vp->top) return;
@@ -1811,6 +2016,12 @@ static inline void ViewportDraw(const Viewport *vp, int left, int top, int right
 	if (top < vp->top) top = vp->top;
 	if (bottom > vp->top + vp->height) bottom = vp->top + vp->height;
 
+	uint num_bands = std::min<uint>(_settings_client.gui.viewport_draw_bands, (bottom - top) / VIEWPORT_MIN_BAND_HEIGHT);
+	if (num_bands > 1) {
+		ViewportDoDrawBands(vp, left, top, right, bottom, num_bands);
+		return;
+	}
+
 	ViewportDoDraw(vp,
 		ScaleByZoom(left - vp->left, vp->zoom) + vp->virtual_left,
 		ScaleByZoom(top - vp->top, vp->zoom) + vp->virtual_top,